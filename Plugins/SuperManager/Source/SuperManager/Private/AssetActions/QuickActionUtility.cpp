@@ -6,6 +6,7 @@
 #include "EditorUtilityLibrary.h"
 #include "EditorAssetLibrary.h"
 #include "ObjectTools.h"
+#include "SuperManager.h"
 
 void UQuickActionUtility::DuplicateAsset(int32 NumOfDuplicates)
 {
@@ -91,11 +92,12 @@ void UQuickActionUtility::RemoveUnusedAssets()
 	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
 	TArray<FAssetData> UnusedAssetsData;
 
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const FAssetReferenceGraph& ReferenceGraph = SuperManagerModule.GetAssetReferenceGraph();
+
 	for(const FAssetData& SelectedAssetData : SelectedAssetsData)
 	{
-		TArray<FString> AssetReferences = UEditorAssetLibrary::FindPackageReferencersForAsset(SelectedAssetData.GetSoftObjectPath().ToString());
-
-		if(AssetReferences.Num() == 0)
+		if(ReferenceGraph.IsAssetUnreferenced(SelectedAssetData))
 		{
 			UnusedAssetsData.Add(SelectedAssetData);
 		}
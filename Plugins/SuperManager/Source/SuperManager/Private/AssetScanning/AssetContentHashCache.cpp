@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetScanning/AssetContentHashCache.h"
+#include "HAL/FileManager.h"
+#include "Serialization/NameAsStringProxyArchive.h"
+
+#define CONTENT_HASH_CACHE_MAGIC 0x534D4348
+#define CONTENT_HASH_CACHE_VERSION 2
+
+FString FAssetContentHashCache::GetDefaultCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("ContentHashCache.bin");
+}
+
+bool FAssetContentHashCache::Load(const FString& CacheFilePath)
+{
+	ContentHashes.Empty();
+	bDirty = false;
+
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*CacheFilePath));
+
+	if(!FileReader) return false;
+
+	FNameAsStringProxyArchive CacheReader(*FileReader);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 NumContentHashes = 0;
+	CacheReader << Magic << Version << NumContentHashes;
+
+	if(Magic != CONTENT_HASH_CACHE_MAGIC || Version != CONTENT_HASH_CACHE_VERSION || NumContentHashes < 0) return false;
+
+	ContentHashes.Reserve(NumContentHashes);
+
+	for(int32 HashIndex = 0; HashIndex < NumContentHashes && !CacheReader.IsError(); ++HashIndex)
+	{
+		FName PackageName;
+		FCachedContentHash CachedContentHash;
+
+		CacheReader << PackageName << CachedContentHash.PackageTimeStamp
+			<< CachedContentHash.ContentHash.Hash << CachedContentHash.ContentHash.PayloadSize;
+
+		ContentHashes.Add(PackageName, CachedContentHash);
+	}
+
+	//A truncated or corrupt cache is thrown away, every package is simply hashed again
+	if(CacheReader.IsError())
+	{
+		ContentHashes.Empty();
+		return false;
+	}
+
+	return true;
+}
+
+bool FAssetContentHashCache::Save(const FString& CacheFilePath)
+{
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*CacheFilePath));
+
+	if(!FileWriter) return false;
+
+	FNameAsStringProxyArchive CacheWriter(*FileWriter);
+
+	uint32 Magic = CONTENT_HASH_CACHE_MAGIC;
+	int32 Version = CONTENT_HASH_CACHE_VERSION;
+	int32 NumContentHashes = ContentHashes.Num();
+	CacheWriter << Magic << Version << NumContentHashes;
+
+	for(const TPair<FName, FCachedContentHash>& ContentHashPair : ContentHashes)
+	{
+		FName PackageName = ContentHashPair.Key;
+		FDateTime PackageTimeStamp = ContentHashPair.Value.PackageTimeStamp;
+		uint64 Hash = ContentHashPair.Value.ContentHash.Hash;
+		int64 PayloadSize = ContentHashPair.Value.ContentHash.PayloadSize;
+
+		CacheWriter << PackageName << PackageTimeStamp << Hash << PayloadSize;
+	}
+
+	if(!FileWriter->Close()) return false;
+
+	bDirty = false;
+
+	return true;
+}
+
+const FAssetContentHash* FAssetContentHashCache::FindContentHash(FName PackageName, const FDateTime& PackageTimeStamp) const
+{
+	//Without a time stamp a changed file could not be told apart from the hashed one
+	if(PackageTimeStamp == FDateTime::MinValue()) return nullptr;
+
+	const FCachedContentHash* CachedContentHash = ContentHashes.Find(PackageName);
+
+	if(!CachedContentHash || CachedContentHash->PackageTimeStamp != PackageTimeStamp) return nullptr;
+
+	return &CachedContentHash->ContentHash;
+}
+
+void FAssetContentHashCache::AddContentHash(FName PackageName, const FDateTime& PackageTimeStamp, const FAssetContentHash& ContentHash)
+{
+	if(PackageTimeStamp == FDateTime::MinValue() || !ContentHash.IsValid()) return;
+
+	ContentHashes.Add(PackageName, { PackageTimeStamp, ContentHash });
+	bDirty = true;
+}
+
+void FAssetContentHashCache::RemoveContentHash(FName PackageName)
+{
+	if(ContentHashes.Remove(PackageName) > 0)
+	{
+		bDirty = true;
+	}
+}
+
+void FAssetContentHashCache::RemoveMissingPackages(TFunctionRef<bool(FName)> DoesPackageExist)
+{
+	for(auto It = ContentHashes.CreateIterator(); It; ++It)
+	{
+		if(DoesPackageExist(It.Key())) continue;
+
+		It.RemoveCurrent();
+		bDirty = true;
+	}
+}
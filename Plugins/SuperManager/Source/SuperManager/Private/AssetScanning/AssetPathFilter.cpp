@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetScanning/AssetPathFilter.h"
+
+void FAssetPathFilter::Compile(const TArray<FSuperManagerPathRule>& PathRules)
+{
+	Nodes.Reset();
+	Nodes.AddDefaulted();
+
+	for(const FSuperManagerPathRule& PathRule : PathRules)
+	{
+		TArray<FString> PathSegments;
+		PathRule.Directory.Path.ParseIntoArray(PathSegments, TEXT("/"));
+
+		if(PathSegments.Num() == 0) continue;
+
+		int32 NodeIndex = 0;
+
+		for(const FString& PathSegment : PathSegments)
+		{
+			const FName SegmentName(*PathSegment);
+
+			if(const int32* ChildIndex = Nodes[NodeIndex].Children.Find(SegmentName))
+			{
+				NodeIndex = *ChildIndex;
+				continue;
+			}
+
+			const int32 NewNodeIndex = Nodes.AddDefaulted();
+			Nodes[NodeIndex].Children.Add(SegmentName, NewNodeIndex);
+			NodeIndex = NewNodeIndex;
+		}
+
+		Nodes[NodeIndex].bHasRule = true;
+		Nodes[NodeIndex].bExcludes = PathRule.RuleType == E_PathRuleType::EPRT_Exclude;
+	}
+}
+
+bool FAssetPathFilter::IsPathExcluded(FStringView Path) const
+{
+	if(Nodes.Num() == 0) return false;
+
+	int32 NodeIndex = 0;
+	bool bExcluded = false;
+	int32 SegmentStart = 0;
+
+	while(SegmentStart < Path.Len())
+	{
+		if(Path[SegmentStart] == TEXT('/'))
+		{
+			++SegmentStart;
+			continue;
+		}
+
+		//A '.' starts the object name of an object path, which is never part of a folder rule
+		int32 SegmentEnd = SegmentStart;
+		while(SegmentEnd < Path.Len() && Path[SegmentEnd] != TEXT('/') && Path[SegmentEnd] != TEXT('.')) ++SegmentEnd;
+
+		//Finding rather than adding the name keeps lookups allocation free, a name nobody added cannot be in the trie
+		const FName SegmentName(Path.Mid(SegmentStart, SegmentEnd - SegmentStart), FNAME_Find);
+
+		const int32* ChildIndex = SegmentName.IsNone() ? nullptr : Nodes[NodeIndex].Children.Find(SegmentName);
+
+		if(!ChildIndex) break;
+
+		NodeIndex = *ChildIndex;
+
+		if(Nodes[NodeIndex].bHasRule) bExcluded = Nodes[NodeIndex].bExcludes;
+
+		if(SegmentEnd < Path.Len() && Path[SegmentEnd] == TEXT('.')) break;
+
+		SegmentStart = SegmentEnd + 1;
+	}
+
+	return bExcluded;
+}
+
+bool FAssetPathFilter::IsPathExcluded(FName Path) const
+{
+	const FNameBuilder PathBuilder(Path);
+
+	return IsPathExcluded(PathBuilder.ToView());
+}
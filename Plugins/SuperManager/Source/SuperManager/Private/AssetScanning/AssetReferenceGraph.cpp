@@ -0,0 +1,432 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetScanning/AssetReferenceGraph.h"
+#include "AssetScanning/AssetScanCache.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/AssetManager.h"
+
+void FAssetReferenceGraph::Build(IAssetRegistry& AssetRegistry, FAssetScanCache* ScanCache)
+{
+	Reset();
+
+	TArray<FAssetData> AllAssetsData;
+	AssetRegistry.GetAllAssets(AllAssetsData, true);
+
+	PackageNames.Reserve(AllAssetsData.Num());
+	PackageIndexMap.Reserve(AllAssetsData.Num());
+
+	for(const FAssetData& AssetData : AllAssetsData)
+	{
+		++PackageAssetCounts[FindOrAddPackage(AssetData.PackageName)];
+	}
+
+	//Packages only seen as dependency targets are appended past this point and have no dependencies of their own to gather
+	const int32 NumScannedPackages = PackageNames.Num();
+
+	//Saved hashes and sizes are read in one pass over the registry's package data, nothing is copied per package
+	TArray<FIoHash> PackageSavedHashes;
+	PackageSavedHashes.Init(FIoHash::Zero, NumScannedPackages);
+
+	TArray<int64> RegistryDiskSizes;
+	RegistryDiskSizes.Init(-1, NumScannedPackages);
+
+	AssetRegistry.EnumerateAllPackages([this, NumScannedPackages, &PackageSavedHashes, &RegistryDiskSizes](FName PackageName, const FAssetPackageData& PackageData)
+	{
+		const int32 PackageIndex = FindPackageIndex(PackageName);
+
+		if(PackageIndex == INDEX_NONE || PackageIndex >= NumScannedPackages) return;
+
+		PackageSavedHashes[PackageIndex] = PackageData.GetPackageSavedHash();
+		RegistryDiskSizes[PackageIndex] = PackageData.DiskSize;
+	});
+
+	for(int32 PackageIndex = 0; PackageIndex < NumScannedPackages; ++PackageIndex)
+	{
+		GatherPackageDependencies(AssetRegistry, PackageIndex, PackageSavedHashes[PackageIndex], RegistryDiskSizes[PackageIndex], ScanCache);
+	}
+
+	if(ScanCache)
+	{
+		ScanCache->RemoveUnusedPackageScans();
+	}
+
+	for(int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+	{
+		UpdateUnreferencedState(PackageIndex);
+	}
+
+	bIsBuilt = true;
+}
+
+void FAssetReferenceGraph::Reset()
+{
+	PackageNames.Empty();
+	PackageIndexMap.Empty();
+	Dependencies.Empty();
+	Referencers.Empty();
+	PackageReferencerCounts.Empty();
+	PackageAssetCounts.Empty();
+	PackageDiskSizes.Empty();
+	UnreferencedPackages.Empty();
+	ReferencerCountChangedPackages.Empty();
+	bIsBuilt = false;
+}
+
+#pragma region IncrementalUpdate
+
+void FAssetReferenceGraph::AddAsset(IAssetRegistry& AssetRegistry, const FAssetData& AddedAssetData, FAssetScanCache* ScanCache)
+{
+	if(!bIsBuilt || FPackageName::IsScriptPackage(AddedAssetData.PackageName.ToString())) return;
+
+	const int32 PackageIndex = FindOrAddPackage(AddedAssetData.PackageName);
+	++PackageAssetCounts[PackageIndex];
+
+	RemovePackageReferences(PackageIndex);
+	GatherPackageDependencies(AssetRegistry, PackageIndex, ScanCache);
+
+	UpdateUnreferencedState(PackageIndex);
+}
+
+void FAssetReferenceGraph::RemoveAsset(const FAssetData& RemovedAssetData, FAssetScanCache* ScanCache)
+{
+	if(!bIsBuilt) return;
+
+	const int32 PackageIndex = FindPackageIndex(RemovedAssetData.PackageName);
+
+	if(PackageIndex == INDEX_NONE || PackageAssetCounts[PackageIndex] == 0) return;
+
+	//Referencers of a removed package keep their edges, they become valid again if the package comes back
+	if(--PackageAssetCounts[PackageIndex] == 0)
+	{
+		RemovePackageReferences(PackageIndex);
+
+		if(ScanCache)
+		{
+			ScanCache->RemovePackageScan(RemovedAssetData.PackageName);
+		}
+	}
+
+	UpdateUnreferencedState(PackageIndex);
+}
+
+void FAssetReferenceGraph::RenameAsset(IAssetRegistry& AssetRegistry, const FAssetData& RenamedAssetData, FName OldPackageName, FAssetScanCache* ScanCache)
+{
+	if(!bIsBuilt) return;
+
+	FAssetData OldAssetData = RenamedAssetData;
+	OldAssetData.PackageName = OldPackageName;
+
+	RemoveAsset(OldAssetData, ScanCache);
+	AddAsset(AssetRegistry, RenamedAssetData, ScanCache);
+}
+
+void FAssetReferenceGraph::RefreshPackage(IAssetRegistry& AssetRegistry, FName PackageName, FAssetScanCache* ScanCache)
+{
+	if(!bIsBuilt) return;
+
+	const int32 PackageIndex = FindPackageIndex(PackageName);
+
+	if(PackageIndex == INDEX_NONE || PackageAssetCounts[PackageIndex] == 0) return;
+
+	RemovePackageReferences(PackageIndex);
+	GatherPackageDependencies(AssetRegistry, PackageIndex, ScanCache);
+}
+
+void FAssetReferenceGraph::ConsumeReferencerCountChanges(TArray<FName>& OutPackageNames)
+{
+	OutPackageNames.Reset(ReferencerCountChangedPackages.Num());
+
+	for(const int32 PackageIndex : ReferencerCountChangedPackages)
+	{
+		OutPackageNames.Add(PackageNames[PackageIndex]);
+	}
+
+	ReferencerCountChangedPackages.Reset();
+}
+
+#pragma endregion
+
+int32 FAssetReferenceGraph::FindPackageIndex(FName PackageName) const
+{
+	const int32* FoundIndex = PackageIndexMap.Find(PackageName);
+
+	return FoundIndex ? *FoundIndex : INDEX_NONE;
+}
+
+int32 FAssetReferenceGraph::GetNumReferencers(int32 PackageIndex, EPackageReferenceType ReferenceTypes) const
+{
+	if(ReferenceTypes == EPackageReferenceType::Package) return PackageReferencerCounts[PackageIndex];
+
+	int32 NumReferencers = 0;
+
+	for(const FPackageReference& Referencer : Referencers[PackageIndex])
+	{
+		if(EnumHasAnyFlags(Referencer.ReferenceType, ReferenceTypes)) ++NumReferencers;
+	}
+
+	return NumReferencers;
+}
+
+bool FAssetReferenceGraph::IsPackageUnreferenced(FName PackageName) const
+{
+	const int32 PackageIndex = FindPackageIndex(PackageName);
+
+	//Never report a package the registry does not know about as safe to delete
+	if(PackageIndex == INDEX_NONE) return false;
+
+	return UnreferencedPackages[PackageIndex];
+}
+
+bool FAssetReferenceGraph::IsAssetUnreferenced(const FAssetData& AssetData) const
+{
+	return IsPackageUnreferenced(AssetData.PackageName);
+}
+
+void FAssetReferenceGraph::GetUnreferencedPackageNames(TArray<FName>& OutPackageNames) const
+{
+	OutPackageNames.Reset();
+
+	for(TConstSetBitIterator<> UnreferencedIt(UnreferencedPackages); UnreferencedIt; ++UnreferencedIt)
+	{
+		OutPackageNames.Add(PackageNames[UnreferencedIt.GetIndex()]);
+	}
+}
+
+void FAssetReferenceGraph::MarkReachablePackages(const TArray<int32>& RootPackageIndices, TBitArray<>& OutReachablePackages) const
+{
+	OutReachablePackages.Init(false, PackageNames.Num());
+
+	TArray<int32> PackagesToVisit;
+	PackagesToVisit.Reserve(PackageNames.Num());
+
+	for(const int32 RootPackageIndex : RootPackageIndices)
+	{
+		if(OutReachablePackages[RootPackageIndex]) continue;
+
+		OutReachablePackages[RootPackageIndex] = true;
+		PackagesToVisit.Add(RootPackageIndex);
+	}
+
+	while(PackagesToVisit.Num() > 0)
+	{
+		const int32 PackageIndex = PackagesToVisit.Pop(EAllowShrinking::No);
+
+		for(const FPackageReference& Dependency : Dependencies[PackageIndex])
+		{
+			if(OutReachablePackages[Dependency.PackageIndex]) continue;
+
+			OutReachablePackages[Dependency.PackageIndex] = true;
+			PackagesToVisit.Add(Dependency.PackageIndex);
+		}
+	}
+}
+
+int32 FAssetReferenceGraph::FindOrAddPackage(FName PackageName)
+{
+	if(const int32* FoundIndex = PackageIndexMap.Find(PackageName))
+	{
+		return *FoundIndex;
+	}
+
+	const int32 NewIndex = PackageNames.Add(PackageName);
+	PackageIndexMap.Add(PackageName, NewIndex);
+	Dependencies.AddDefaulted();
+	Referencers.AddDefaulted();
+	PackageReferencerCounts.Add(0);
+	PackageAssetCounts.Add(0);
+	PackageDiskSizes.Add(-1);
+	UnreferencedPackages.Add(false);
+
+	return NewIndex;
+}
+
+void FAssetReferenceGraph::RemovePackageReferences(int32 PackageIndex)
+{
+	//Outgoing edges are copied because RemoveReference shrinks the array being walked.
+	//Outgoing management edges are owned by the managed packages and are left alone
+	const TArray<FPackageReference> OldDependencies = Dependencies[PackageIndex];
+
+	for(const FPackageReference& OldDependency : OldDependencies)
+	{
+		RemoveReference(PackageIndex, OldDependency.PackageIndex, EPackageReferenceType::Package);
+	}
+
+	//Incoming management edges are gathered from this package's side as well, so they go with it
+	const TArray<FPackageReference> OldReferencers = Referencers[PackageIndex];
+
+	for(const FPackageReference& OldReferencer : OldReferencers)
+	{
+		if(EnumHasAnyFlags(OldReferencer.ReferenceType, EPackageReferenceType::Management))
+		{
+			RemoveReference(OldReferencer.PackageIndex, PackageIndex, EPackageReferenceType::Management);
+		}
+	}
+}
+
+void FAssetReferenceGraph::RemoveReference(int32 ReferencerIndex, int32 DependencyIndex, EPackageReferenceType ReferenceTypes)
+{
+	const int32 DependencySlot = Dependencies[ReferencerIndex].IndexOfByPredicate(
+		[DependencyIndex](const FPackageReference& Reference) { return Reference.PackageIndex == DependencyIndex; });
+
+	if(DependencySlot == INDEX_NONE) return;
+
+	const int32 ReferencerSlot = Referencers[DependencyIndex].IndexOfByPredicate(
+		[ReferencerIndex](const FPackageReference& Reference) { return Reference.PackageIndex == ReferencerIndex; });
+
+	FPackageReference& Dependency = Dependencies[ReferencerIndex][DependencySlot];
+
+	const bool bWasPackageReference = EnumHasAnyFlags(Dependency.ReferenceType, EPackageReferenceType::Package);
+
+	Dependency.ReferenceType &= ~ReferenceTypes;
+
+	if(bWasPackageReference && !EnumHasAnyFlags(Dependency.ReferenceType, EPackageReferenceType::Package))
+	{
+		ChangeReferencerCount(DependencyIndex, -1);
+	}
+
+	if(Dependency.ReferenceType == EPackageReferenceType::None)
+	{
+		Dependencies[ReferencerIndex].RemoveAtSwap(DependencySlot, 1, EAllowShrinking::No);
+		Referencers[DependencyIndex].RemoveAtSwap(ReferencerSlot, 1, EAllowShrinking::No);
+	}
+	else
+	{
+		Referencers[DependencyIndex][ReferencerSlot].ReferenceType = Dependency.ReferenceType;
+	}
+
+	UpdateUnreferencedState(DependencyIndex);
+}
+
+void FAssetReferenceGraph::UpdateUnreferencedState(int32 PackageIndex)
+{
+	UnreferencedPackages[PackageIndex] = PackageAssetCounts[PackageIndex] > 0 && PackageReferencerCounts[PackageIndex] == 0;
+}
+
+void FAssetReferenceGraph::ChangeReferencerCount(int32 PackageIndex, int32 Delta)
+{
+	PackageReferencerCounts[PackageIndex] += Delta;
+
+	if(bIsBuilt)
+	{
+		ReferencerCountChangedPackages.Add(PackageIndex);
+	}
+}
+
+void FAssetReferenceGraph::GatherPackageDependencies(IAssetRegistry& AssetRegistry, int32 PackageIndex, FAssetScanCache* ScanCache)
+{
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageNames[PackageIndex]);
+
+	GatherPackageDependencies(AssetRegistry, PackageIndex,
+		PackageData.IsSet() ? PackageData->GetPackageSavedHash() : FIoHash::Zero, PackageData.IsSet() ? PackageData->DiskSize : -1, ScanCache);
+}
+
+void FAssetReferenceGraph::GatherPackageDependencies(IAssetRegistry& AssetRegistry, int32 PackageIndex, const FIoHash& PackageSavedHash,
+	int64 RegistryDiskSize, FAssetScanCache* ScanCache)
+{
+	const FAssetIdentifier PackageIdentifier(PackageNames[PackageIndex]);
+
+	if(const FCachedPackageScan* CachedPackageScan = ScanCache ? ScanCache->FindPackageScan(PackageNames[PackageIndex], PackageSavedHash) : nullptr)
+	{
+		PackageDiskSizes[PackageIndex] = CachedPackageScan->DiskSize;
+
+		for(const FCachedPackageDependency& CachedDependency : CachedPackageScan->Dependencies)
+		{
+			AddReference(PackageIndex, FindOrAddPackage(CachedDependency.PackageName), CachedDependency.ReferenceType);
+		}
+	}
+	else
+	{
+		PackageDiskSizes[PackageIndex] = RegistryDiskSize;
+
+		FCachedPackageScan NewPackageScan;
+		NewPackageScan.PackageSavedHash = PackageSavedHash;
+		NewPackageScan.DiskSize = PackageDiskSizes[PackageIndex];
+
+		TArray<FAssetDependency> PackageDependencies;
+		AssetRegistry.GetDependencies(PackageIdentifier, PackageDependencies, UE::AssetRegistry::EDependencyCategory::Package);
+
+		for(const FAssetDependency& PackageDependency : PackageDependencies)
+		{
+			const FName DependencyName = PackageDependency.AssetId.PackageName;
+
+			if(DependencyName.IsNone() || DependencyName == PackageNames[PackageIndex]) continue;
+
+			if(FPackageName::IsScriptPackage(DependencyName.ToString())) continue;
+
+			const EPackageReferenceType ReferenceType =
+				EnumHasAnyFlags(PackageDependency.Properties, UE::AssetRegistry::EDependencyProperty::Hard) ?
+				EPackageReferenceType::Hard : EPackageReferenceType::Soft;
+
+			AddReference(PackageIndex, FindOrAddPackage(DependencyName), ReferenceType);
+
+			NewPackageScan.Dependencies.Add({DependencyName, ReferenceType});
+		}
+
+		if(ScanCache)
+		{
+			ScanCache->AddPackageScan(PackageNames[PackageIndex], MoveTemp(NewPackageScan));
+		}
+	}
+
+	//Management edges are stored manager -> managed, so they are gathered from the managed side.
+	//They follow the asset manager configuration rather than the package file, so they are never cached
+	TArray<FAssetIdentifier> Managers;
+	AssetRegistry.GetReferencers(PackageIdentifier, Managers, UE::AssetRegistry::EDependencyCategory::Manage);
+
+	for(const FAssetIdentifier& Manager : Managers)
+	{
+		const FName ManagerPackageName = GetManagerPackageName(Manager);
+
+		if(ManagerPackageName.IsNone() || ManagerPackageName == PackageNames[PackageIndex]) continue;
+
+		AddReference(FindOrAddPackage(ManagerPackageName), PackageIndex, EPackageReferenceType::Management);
+	}
+}
+
+void FAssetReferenceGraph::AddReference(int32 ReferencerIndex, int32 DependencyIndex, EPackageReferenceType ReferenceType)
+{
+	FPackageReference* ExistingDependency = Dependencies[ReferencerIndex].FindByPredicate(
+		[DependencyIndex](const FPackageReference& Reference) { return Reference.PackageIndex == DependencyIndex; });
+
+	if(ExistingDependency)
+	{
+		FPackageReference* ExistingReferencer = Referencers[DependencyIndex].FindByPredicate(
+			[ReferencerIndex](const FPackageReference& Reference) { return Reference.PackageIndex == ReferencerIndex; });
+
+		const bool bWasPackageReference = EnumHasAnyFlags(ExistingDependency->ReferenceType, EPackageReferenceType::Package);
+
+		ExistingDependency->ReferenceType |= ReferenceType;
+		ExistingReferencer->ReferenceType |= ReferenceType;
+
+		if(!bWasPackageReference && EnumHasAnyFlags(ReferenceType, EPackageReferenceType::Package))
+		{
+			ChangeReferencerCount(DependencyIndex, 1);
+			UpdateUnreferencedState(DependencyIndex);
+		}
+
+		return;
+	}
+
+	Dependencies[ReferencerIndex].Add({DependencyIndex, ReferenceType});
+	Referencers[DependencyIndex].Add({ReferencerIndex, ReferenceType});
+
+	if(EnumHasAnyFlags(ReferenceType, EPackageReferenceType::Package))
+	{
+		ChangeReferencerCount(DependencyIndex, 1);
+		UpdateUnreferencedState(DependencyIndex);
+	}
+}
+
+FName FAssetReferenceGraph::GetManagerPackageName(const FAssetIdentifier& ManagerIdentifier)
+{
+	if(!ManagerIdentifier.PackageName.IsNone()) return ManagerIdentifier.PackageName;
+
+	const FPrimaryAssetId ManagerPrimaryAssetId = ManagerIdentifier.GetPrimaryAssetId();
+
+	if(!ManagerPrimaryAssetId.IsValid() || !UAssetManager::IsInitialized()) return NAME_None;
+
+	const FSoftObjectPath ManagerAssetPath = UAssetManager::Get().GetPrimaryAssetPath(ManagerPrimaryAssetId);
+
+	return ManagerAssetPath.IsValid() ? ManagerAssetPath.GetLongPackageFName() : NAME_None;
+}
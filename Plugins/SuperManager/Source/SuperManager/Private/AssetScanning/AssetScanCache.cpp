@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetScanning/AssetScanCache.h"
+#include "HAL/FileManager.h"
+#include "Serialization/NameAsStringProxyArchive.h"
+
+#define SCAN_CACHE_MAGIC 0x534D5343
+#define SCAN_CACHE_VERSION 1
+
+//Smallest serialized size of a package scan and of one of its dependencies, an empty name string takes its 4 byte length
+#define SCAN_CACHE_MIN_PACKAGE_SCAN_SIZE (4 + sizeof(FIoHash) + sizeof(int64) + sizeof(int32))
+#define SCAN_CACHE_MIN_DEPENDENCY_SIZE (4 + sizeof(uint8))
+
+FString FAssetScanCache::GetDefaultCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("ScanCache.bin");
+}
+
+bool FAssetScanCache::Load(const FString& CacheFilePath)
+{
+	PackageScans.Empty();
+	bDirty = false;
+
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*CacheFilePath));
+
+	if(!FileReader) return false;
+
+	FNameAsStringProxyArchive CacheReader(*FileReader);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 NumPackageScans = 0;
+	CacheReader << Magic << Version << NumPackageScans;
+
+	if(Magic != SCAN_CACHE_MAGIC || Version != SCAN_CACHE_VERSION || NumPackageScans < 0) return false;
+
+	//Counts are checked against the bytes left, so a corrupt count cannot reserve more than the file could hold
+	auto GetRemainingSize = [&FileReader]() { return FileReader->TotalSize() - FileReader->Tell(); };
+
+	if(NumPackageScans > GetRemainingSize() / static_cast<int64>(SCAN_CACHE_MIN_PACKAGE_SCAN_SIZE)) return false;
+
+	PackageScans.Reserve(NumPackageScans);
+
+	for(int32 ScanIndex = 0; ScanIndex < NumPackageScans && !CacheReader.IsError(); ++ScanIndex)
+	{
+		FName PackageName;
+		FCachedPackageScan PackageScan;
+		int32 NumDependencies = 0;
+
+		CacheReader << PackageName << PackageScan.PackageSavedHash << PackageScan.DiskSize << NumDependencies;
+
+		if(NumDependencies < 0 || NumDependencies > GetRemainingSize() / static_cast<int64>(SCAN_CACHE_MIN_DEPENDENCY_SIZE))
+		{
+			CacheReader.SetError();
+			break;
+		}
+
+		PackageScan.Dependencies.SetNum(NumDependencies);
+
+		for(FCachedPackageDependency& Dependency : PackageScan.Dependencies)
+		{
+			uint8 ReferenceType = 0;
+			CacheReader << Dependency.PackageName << ReferenceType;
+
+			Dependency.ReferenceType = static_cast<EPackageReferenceType>(ReferenceType);
+		}
+
+		PackageScans.Add(PackageName, MoveTemp(PackageScan));
+	}
+
+	//A truncated or corrupt cache is thrown away, every package is simply scanned again
+	if(CacheReader.IsError())
+	{
+		PackageScans.Empty();
+		return false;
+	}
+
+	return true;
+}
+
+bool FAssetScanCache::Save(const FString& CacheFilePath)
+{
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*CacheFilePath));
+
+	if(!FileWriter) return false;
+
+	FNameAsStringProxyArchive CacheWriter(*FileWriter);
+
+	uint32 Magic = SCAN_CACHE_MAGIC;
+	int32 Version = SCAN_CACHE_VERSION;
+	int32 NumPackageScans = PackageScans.Num();
+	CacheWriter << Magic << Version << NumPackageScans;
+
+	for(const TPair<FName, FCachedPackageScan>& PackageScanPair : PackageScans)
+	{
+		FName PackageName = PackageScanPair.Key;
+		FIoHash PackageSavedHash = PackageScanPair.Value.PackageSavedHash;
+		int64 DiskSize = PackageScanPair.Value.DiskSize;
+		int32 NumDependencies = PackageScanPair.Value.Dependencies.Num();
+
+		CacheWriter << PackageName << PackageSavedHash << DiskSize << NumDependencies;
+
+		for(const FCachedPackageDependency& Dependency : PackageScanPair.Value.Dependencies)
+		{
+			FName DependencyName = Dependency.PackageName;
+			uint8 ReferenceType = static_cast<uint8>(Dependency.ReferenceType);
+
+			CacheWriter << DependencyName << ReferenceType;
+		}
+	}
+
+	if(!FileWriter->Close()) return false;
+
+	bDirty = false;
+
+	return true;
+}
+
+const FCachedPackageScan* FAssetScanCache::FindPackageScan(FName PackageName, const FIoHash& PackageSavedHash)
+{
+	//Packages without a saved hash (never saved, or gathered by an older engine) cannot be validated
+	if(PackageSavedHash.IsZero()) return nullptr;
+
+	FCachedPackageScan* PackageScan = PackageScans.Find(PackageName);
+
+	if(!PackageScan || PackageScan->PackageSavedHash != PackageSavedHash) return nullptr;
+
+	PackageScan->bUsedThisBuild = true;
+
+	return PackageScan;
+}
+
+void FAssetScanCache::AddPackageScan(FName PackageName, FCachedPackageScan&& PackageScan)
+{
+	if(PackageScan.PackageSavedHash.IsZero()) return;
+
+	PackageScan.bUsedThisBuild = true;
+
+	PackageScans.Add(PackageName, MoveTemp(PackageScan));
+	bDirty = true;
+}
+
+void FAssetScanCache::RemovePackageScan(FName PackageName)
+{
+	if(PackageScans.Remove(PackageName) > 0) bDirty = true;
+}
+
+void FAssetScanCache::RemoveUnusedPackageScans()
+{
+	for(auto PackageScanIt = PackageScans.CreateIterator(); PackageScanIt; ++PackageScanIt)
+	{
+		if(!PackageScanIt->Value.bUsedThisBuild)
+		{
+			PackageScanIt.RemoveCurrent();
+			bDirty = true;
+			continue;
+		}
+
+		PackageScanIt->Value.bUsedThisBuild = false;
+	}
+}
@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetScanning/AssetSourceHashCache.h"
+#include "HAL/FileManager.h"
+#include "Serialization/NameAsStringProxyArchive.h"
+
+#define SOURCE_HASH_CACHE_MAGIC 0x534D5348
+#define SOURCE_HASH_CACHE_VERSION 2
+
+FString FAssetSourceHashCache::GetCacheFilePath(const TCHAR* CacheFileName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SuperManager") / CacheFileName;
+}
+
+bool FAssetSourceHashCache::Load(const FString& CacheFilePath)
+{
+	SourceHashes.Empty();
+	bDirty = false;
+
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*CacheFilePath));
+
+	if(!FileReader) return false;
+
+	FNameAsStringProxyArchive CacheReader(*FileReader);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 NumSourceHashes = 0;
+	CacheReader << Magic << Version << NumSourceHashes;
+
+	if(Magic != SOURCE_HASH_CACHE_MAGIC || Version != SOURCE_HASH_CACHE_VERSION || NumSourceHashes < 0) return false;
+
+	SourceHashes.Reserve(NumSourceHashes);
+
+	for(int32 HashIndex = 0; HashIndex < NumSourceHashes && !CacheReader.IsError(); ++HashIndex)
+	{
+		FName PackageName;
+		FCachedSourceHash CachedSourceHash;
+
+		CacheReader << PackageName << CachedSourceHash.PackageSavedHash << CachedSourceHash.SourceHash;
+
+		SourceHashes.Add(PackageName, CachedSourceHash);
+	}
+
+	//A truncated or corrupt cache is thrown away, every asset is simply read again
+	if(CacheReader.IsError())
+	{
+		SourceHashes.Empty();
+		return false;
+	}
+
+	return true;
+}
+
+bool FAssetSourceHashCache::Save(const FString& CacheFilePath)
+{
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*CacheFilePath));
+
+	if(!FileWriter) return false;
+
+	FNameAsStringProxyArchive CacheWriter(*FileWriter);
+
+	uint32 Magic = SOURCE_HASH_CACHE_MAGIC;
+	int32 Version = SOURCE_HASH_CACHE_VERSION;
+	int32 NumSourceHashes = SourceHashes.Num();
+	CacheWriter << Magic << Version << NumSourceHashes;
+
+	for(const TPair<FName, FCachedSourceHash>& SourceHashPair : SourceHashes)
+	{
+		FName PackageName = SourceHashPair.Key;
+		FIoHash PackageSavedHash = SourceHashPair.Value.PackageSavedHash;
+		uint64 SourceHash = SourceHashPair.Value.SourceHash;
+
+		CacheWriter << PackageName << PackageSavedHash << SourceHash;
+	}
+
+	if(!FileWriter->Close()) return false;
+
+	bDirty = false;
+
+	return true;
+}
+
+const uint64* FAssetSourceHashCache::FindSourceHash(FName PackageName, const FIoHash& PackageSavedHash) const
+{
+	//Packages saved before saved hashes existed cannot be told apart from a resaved version
+	if(PackageSavedHash.IsZero()) return nullptr;
+
+	const FCachedSourceHash* CachedSourceHash = SourceHashes.Find(PackageName);
+
+	if(!CachedSourceHash || CachedSourceHash->PackageSavedHash != PackageSavedHash) return nullptr;
+
+	return &CachedSourceHash->SourceHash;
+}
+
+void FAssetSourceHashCache::AddSourceHash(FName PackageName, const FIoHash& PackageSavedHash, uint64 SourceHash)
+{
+	if(PackageSavedHash.IsZero()) return;
+
+	SourceHashes.Add(PackageName, { PackageSavedHash, SourceHash });
+	bDirty = true;
+}
+
+void FAssetSourceHashCache::RemoveSourceHash(FName PackageName)
+{
+	if(SourceHashes.Remove(PackageName) > 0)
+	{
+		bDirty = true;
+	}
+}
+
+void FAssetSourceHashCache::RemoveMissingPackages(TFunctionRef<bool(FName)> DoesPackageExist)
+{
+	for(auto It = SourceHashes.CreateIterator(); It; ++It)
+	{
+		if(DoesPackageExist(It.Key())) continue;
+
+		It.RemoveCurrent();
+		bDirty = true;
+	}
+}
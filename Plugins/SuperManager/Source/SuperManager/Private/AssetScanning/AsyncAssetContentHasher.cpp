@@ -0,0 +1,278 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetScanning/AsyncAssetContentHasher.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/PackageName.h"
+#include "UObject/PackageFileSummary.h"
+
+//Package files are read this much at a time, each worker reuses one buffer of this size
+#define ContentHashReadChunkSize (256 * 1024)
+
+//Exports up to this size are read whole so their names can be normalized, larger ones are hashed as stored
+#define ContentHashMaxNormalizedExportsSize (64 * 1024 * 1024)
+
+//Highest name number taken for the number half of a serialized name, larger values are left as they are
+#define ContentHashMaxNameNumber (1 << 16)
+
+//Hashes the name map in an order independent of the package's own name, which stands in for whatever the package is called.
+//Fills the canonical index of every entry of the name map, the position it would have in that order.
+static bool HashCanonicalNameMap(FArchive& PackageReader, const FPackageFileSummary& PackageSummary, FName PackageName,
+	TArray<int32>& OutCanonicalNameIndices, FXxHash64Builder& HashBuilder)
+{
+	if(PackageSummary.NameCount < 0 || PackageSummary.NameOffset <= 0 || PackageSummary.NameOffset >= PackageSummary.TotalHeaderSize) return false;
+
+	const FString PackageNameString = PackageName.ToString();
+	const FString AssetNameString = FPackageName::GetShortName(PackageNameString);
+
+	const bool bNameHashesSerialized = PackageSummary.GetFileVersionUE() >= VER_UE4_NAME_HASHES_SERIALIZED;
+
+	TArray<FString> NameStrings;
+	NameStrings.SetNum(PackageSummary.NameCount);
+
+	PackageReader.Seek(PackageSummary.NameOffset);
+
+	for(FString& NameString : NameStrings)
+	{
+		PackageReader << NameString;
+
+		if(bNameHashesSerialized)
+		{
+			uint16 NameHashes[2];
+			PackageReader.Serialize(NameHashes, sizeof(NameHashes));
+		}
+
+		if(PackageReader.IsError()) return false;
+
+		//A renamed copy only differs in these, control characters never occur in real names
+		if(NameString.Equals(AssetNameString, ESearchCase::IgnoreCase))
+		{
+			NameString = TEXT("\x01");
+		}
+		else if(NameString.Equals(PackageNameString, ESearchCase::IgnoreCase))
+		{
+			NameString = TEXT("\x02");
+		}
+	}
+
+	TArray<int32> SortedNameIndices;
+	SortedNameIndices.SetNumUninitialized(NameStrings.Num());
+
+	for(int32 NameIndex = 0; NameIndex < NameStrings.Num(); ++NameIndex)
+	{
+		SortedNameIndices[NameIndex] = NameIndex;
+	}
+
+	SortedNameIndices.Sort([&NameStrings](int32 A, int32 B)
+	{
+		return NameStrings[A].Compare(NameStrings[B], ESearchCase::CaseSensitive) < 0;
+	});
+
+	OutCanonicalNameIndices.SetNumUninitialized(NameStrings.Num());
+
+	for(int32 CanonicalIndex = 0; CanonicalIndex < SortedNameIndices.Num(); ++CanonicalIndex)
+	{
+		const FString& NameString = NameStrings[SortedNameIndices[CanonicalIndex]];
+		const int32 NameLength = NameString.Len();
+
+		OutCanonicalNameIndices[SortedNameIndices[CanonicalIndex]] = CanonicalIndex;
+
+		//The length keeps neighbouring names from running into each other
+		HashBuilder.Update(&NameLength, sizeof(NameLength));
+		HashBuilder.Update(*NameString, NameLength * sizeof(TCHAR));
+	}
+
+	return true;
+}
+
+//Exports store names as an index into the name map followed by a number, every such pair is hashed with its canonical index.
+//Where names sit is only known to the classes serializing them, so every position holding a valid pair is taken for one.
+//Bytes that merely look like a pair do so in both copies of an asset and are replaced alike, but two distinct assets can
+//then hash alike too, so consolidation compares the assets themselves before removing any.
+static void HashNormalizedExports(TConstArrayView<uint8> ExportsData, const TArray<int32>& CanonicalNameIndices, FXxHash64Builder& HashBuilder)
+{
+	const uint8* Data = ExportsData.GetData();
+	const int64 DataSize = ExportsData.Num();
+	const uint32 NumNames = CanonicalNameIndices.Num();
+
+	int64 RunStart = 0;
+	int64 Position = 0;
+
+	while(Position + 8 <= DataSize)
+	{
+		uint32 NameIndex;
+		uint32 NameNumber;
+		FMemory::Memcpy(&NameIndex, Data + Position, sizeof(NameIndex));
+		FMemory::Memcpy(&NameNumber, Data + Position + 4, sizeof(NameNumber));
+
+		if(NameIndex >= NumNames || NameNumber > ContentHashMaxNameNumber)
+		{
+			++Position;
+			continue;
+		}
+
+		HashBuilder.Update(Data + RunStart, Position - RunStart);
+
+		const int32 CanonicalNameIndex = CanonicalNameIndices[NameIndex];
+		HashBuilder.Update(&CanonicalNameIndex, sizeof(CanonicalNameIndex));
+		HashBuilder.Update(&NameNumber, sizeof(NameNumber));
+
+		Position += 8;
+		RunStart = Position;
+	}
+
+	HashBuilder.Update(Data + RunStart, DataSize - RunStart);
+}
+
+void FAsyncAssetContentHasher::Enqueue(TArray<FAssetContentHashRequest>&& HashRequests)
+{
+	if(HashRequests.Num() == 0) return;
+
+	++NumPendingBatches;
+
+	//The task keeps the hasher alive, so the widget that enqueued the batch may close at any time
+	Async(EAsyncExecution::ThreadPool, [Hasher = AsShared(), HashRequests = MoveTemp(HashRequests)]()
+	{
+		Hasher->HashOnWorkerThread(HashRequests);
+		--Hasher->NumPendingBatches;
+	});
+}
+
+void FAsyncAssetContentHasher::Cancel()
+{
+	bCancelRequested = true;
+}
+
+int32 FAsyncAssetContentHasher::ConsumeHashResults(TArray<FAssetContentHashResult>& OutHashResults)
+{
+	FScopeLock FinishedHashResultsScopeLock(&FinishedHashResultsLock);
+
+	const int32 NumConsumedResults = FinishedHashResults.Num();
+
+	OutHashResults.Append(MoveTemp(FinishedHashResults));
+	FinishedHashResults.Reset();
+
+	return NumConsumedResults;
+}
+
+void FAsyncAssetContentHasher::HashOnWorkerThread(const TArray<FAssetContentHashRequest>& HashRequests)
+{
+	if(bCancelRequested) return;
+
+	TArray<FAssetContentHashResult> HashResults;
+	HashResults.SetNum(HashRequests.Num());
+
+	TArray<TArray<uint8>> ReadBuffers;
+
+	//Reading dominates, files are independent and spread over every worker
+	ParallelForWithTaskContext(ReadBuffers, HashRequests.Num(), [&](TArray<uint8>& ReadBuffer, int32 RequestIndex)
+	{
+		if(bCancelRequested) return;
+
+		const FAssetContentHashRequest& HashRequest = HashRequests[RequestIndex];
+		FAssetContentHashResult& HashResult = HashResults[RequestIndex];
+
+		HashResult.ItemIndex = HashRequest.ItemIndex;
+		HashResult.PackageName = HashRequest.PackageName;
+		HashResult.PackageTimeStamp = HashRequest.PackageTimeStamp;
+		HashResult.ContentHash = HashPackageFile(HashRequest.PackageName, ReadBuffer);
+	});
+
+	if(bCancelRequested) return;
+
+	FScopeLock FinishedHashResultsScopeLock(&FinishedHashResultsLock);
+	FinishedHashResults.Append(MoveTemp(HashResults));
+}
+
+FAssetContentHash FAsyncAssetContentHasher::HashPackageFile(FName PackageName, TArray<uint8>& ReadBuffer) const
+{
+	const FString PackageFilename = FindPackageFilename(PackageName);
+
+	if(PackageFilename.IsEmpty()) return FAssetContentHash();
+
+	TUniquePtr<FArchive> PackageReader(IFileManager::Get().CreateFileReader(*PackageFilename, FILEREAD_Silent));
+
+	if(!PackageReader) return FAssetContentHash();
+
+	//The summary tells where the name map is and where the header ends
+	FPackageFileSummary PackageSummary;
+	*PackageReader << PackageSummary;
+
+	const int64 PackageFileSize = PackageReader->TotalSize();
+	const int64 PayloadOffset = PackageSummary.TotalHeaderSize;
+
+	if(PackageReader->IsError() || PackageSummary.Tag != PACKAGE_FILE_TAG || PayloadOffset <= 0 || PayloadOffset > PackageFileSize)
+	{
+		return FAssetContentHash();
+	}
+
+	//Read the way the engine reads them, the name map's layout depends on the version the package was saved with
+	PackageReader->SetUEVer(PackageSummary.GetFileVersionUE());
+	PackageReader->SetLicenseeUEVer(PackageSummary.GetFileVersionLicenseeUE());
+
+	FXxHash64Builder HashBuilder;
+	TArray<int32> CanonicalNameIndices;
+
+	if(!HashCanonicalNameMap(*PackageReader, PackageSummary, PackageName, CanonicalNameIndices, HashBuilder)) return FAssetContentHash();
+
+	//Bulk data, when stored in the package, follows the exports and holds no names
+	const int64 ExportsEndOffset = PackageSummary.BulkDataStartOffset > PayloadOffset && PackageSummary.BulkDataStartOffset < PackageFileSize
+		? PackageSummary.BulkDataStartOffset : PackageFileSize;
+
+	const int64 ExportsSize = ExportsEndOffset - PayloadOffset;
+
+	PackageReader->Seek(PayloadOffset);
+
+	if(ExportsSize <= ContentHashMaxNormalizedExportsSize)
+	{
+		ReadBuffer.SetNumUninitialized(FMath::Max<int32>((int32)ExportsSize, ContentHashReadChunkSize), EAllowShrinking::No);
+
+		PackageReader->Serialize(ReadBuffer.GetData(), ExportsSize);
+
+		if(PackageReader->IsError() || bCancelRequested) return FAssetContentHash();
+
+		HashNormalizedExports(MakeArrayView(ReadBuffer.GetData(), ExportsSize), CanonicalNameIndices, HashBuilder);
+	}
+	else if(ReadBuffer.Num() == 0)
+	{
+		ReadBuffer.SetNumUninitialized(ContentHashReadChunkSize);
+	}
+
+	for(int64 RemainingSize = PackageFileSize - PackageReader->Tell(); RemainingSize > 0;)
+	{
+		if(bCancelRequested) return FAssetContentHash();
+
+		const int64 ChunkSize = FMath::Min<int64>(RemainingSize, ReadBuffer.Num());
+
+		PackageReader->Serialize(ReadBuffer.GetData(), ChunkSize);
+
+		if(PackageReader->IsError()) return FAssetContentHash();
+
+		HashBuilder.Update(ReadBuffer.GetData(), ChunkSize);
+		RemainingSize -= ChunkSize;
+	}
+
+	FAssetContentHash ContentHash;
+	ContentHash.Hash = HashBuilder.Finalize().Hash;
+	ContentHash.PayloadSize = PackageFileSize - PayloadOffset;
+
+	return ContentHash;
+}
+
+FString FAsyncAssetContentHasher::FindPackageFilename(FName PackageName)
+{
+	FString PackageFilename;
+
+	//Asset packages are far more common than maps, so maps cost the second stat
+	for(const FString& PackageExtension : { FPackageName::GetAssetPackageExtension(), FPackageName::GetMapPackageExtension() })
+	{
+		if(!FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), PackageFilename, PackageExtension)) break;
+
+		if(IFileManager::Get().FileExists(*PackageFilename)) return PackageFilename;
+	}
+
+	return FString();
+}
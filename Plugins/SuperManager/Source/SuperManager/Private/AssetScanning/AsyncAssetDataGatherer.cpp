@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetScanning/AsyncAssetDataGatherer.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+
+//Assets processed between cancellation checks and handed over at once
+#define GATHER_CHUNK_SIZE 512
+
+FAsyncAssetDataGatherer::FAsyncAssetDataGatherer(const TArray<FString>& InRootFolderPaths, const FAssetPathFilter& InAssetPathFilter)
+	: RootFolderPaths(InRootFolderPaths)
+	, AssetPathFilter(InAssetPathFilter)
+{
+}
+
+void FAsyncAssetDataGatherer::Start()
+{
+	//The task keeps the gatherer alive, so the widget that started it may close at any time
+	Async(EAsyncExecution::ThreadPool, [Gatherer = AsShared()]()
+	{
+		Gatherer->GatherOnWorkerThread();
+	});
+}
+
+void FAsyncAssetDataGatherer::Cancel()
+{
+	bCancelRequested = true;
+}
+
+int32 FAsyncAssetDataGatherer::ConsumeGatheredAssetsData(TArray<FGatheredAssetData>& OutAssetsData, int32 MaxAssets)
+{
+	FScopeLock PendingAssetsDataScopeLock(&PendingAssetsDataLock);
+
+	const int32 NumConsumedAssets = FMath::Min(PendingAssetsData.Num() - NumConsumedPendingAssets, MaxAssets);
+
+	OutAssetsData.Reserve(OutAssetsData.Num() + NumConsumedAssets);
+
+	for(int32 AssetIndex = 0; AssetIndex < NumConsumedAssets; ++AssetIndex)
+	{
+		OutAssetsData.Add(MoveTemp(PendingAssetsData[NumConsumedPendingAssets + AssetIndex]));
+	}
+
+	NumConsumedPendingAssets += NumConsumedAssets;
+
+	//Compacting only once the consumed part is the larger half keeps every pending asset moved at most once on average
+	if(NumConsumedPendingAssets == PendingAssetsData.Num())
+	{
+		PendingAssetsData.Reset();
+		NumConsumedPendingAssets = 0;
+	}
+	else if(NumConsumedPendingAssets > PendingAssetsData.Num() / 2)
+	{
+		PendingAssetsData.RemoveAt(0, NumConsumedPendingAssets, EAllowShrinking::No);
+		NumConsumedPendingAssets = 0;
+	}
+
+	return NumConsumedAssets;
+}
+
+void FAsyncAssetDataGatherer::GatherOnWorkerThread()
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	//One recursive query over every root, on disk assets only, in memory assets would touch UObjects off the game thread
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+
+	for(const FString& RootFolderPath : RootFolderPaths)
+	{
+		Filter.PackagePaths.Emplace(RootFolderPath);
+	}
+
+	TArray<FAssetData> QueriedAssetsData;
+
+	if(Filter.PackagePaths.Num() > 0 && !bCancelRequested)
+	{
+		AssetRegistry.GetAssets(Filter, QueriedAssetsData);
+	}
+
+	TMap<FName, FDateTime> PackageTimeStamps;
+
+	for(int32 ChunkStart = 0; ChunkStart < QueriedAssetsData.Num() && !bCancelRequested; ChunkStart += GATHER_CHUNK_SIZE)
+	{
+		const int32 ChunkEnd = FMath::Min(ChunkStart + GATHER_CHUNK_SIZE, QueriedAssetsData.Num());
+
+		TArray<FGatheredAssetData> ChunkGatheredAssetsData;
+		ChunkGatheredAssetsData.Reserve(ChunkEnd - ChunkStart);
+
+		//Package files are stat'ed once, no matter how many assets they hold
+		PackageTimeStamps.Reset();
+
+		for(int32 AssetIndex = ChunkStart; AssetIndex < ChunkEnd; ++AssetIndex)
+		{
+			FAssetData& AssetData = QueriedAssetsData[AssetIndex];
+
+			if(AssetData.IsRedirector() || AssetPathFilter.IsPathExcluded(AssetData.PackagePath)) continue;
+
+			FGatheredAssetData& GatheredAssetData = ChunkGatheredAssetsData.AddDefaulted_GetRef();
+			GatheredAssetData.PackageTimeStamp = GetPackageTimeStamp(AssetData.PackageName, PackageTimeStamps);
+			GatheredAssetData.AssetData = MoveTemp(AssetData);
+		}
+
+		if(ChunkGatheredAssetsData.Num() == 0) continue;
+
+		NumGatheredAssets += ChunkGatheredAssetsData.Num();
+
+		FScopeLock PendingAssetsDataScopeLock(&PendingAssetsDataLock);
+		PendingAssetsData.Append(MoveTemp(ChunkGatheredAssetsData));
+	}
+
+	bIsComplete = true;
+}
+
+FDateTime FAsyncAssetDataGatherer::GetPackageTimeStamp(FName PackageName, TMap<FName, FDateTime>& PackageTimeStamps)
+{
+	if(const FDateTime* PackageTimeStamp = PackageTimeStamps.Find(PackageName))
+	{
+		return *PackageTimeStamp;
+	}
+
+	FDateTime PackageTimeStamp = FDateTime::MinValue();
+	FString PackageFilename;
+
+	//Asset packages are far more common than maps, so maps cost the second stat
+	for(const FString& PackageExtension : { FPackageName::GetAssetPackageExtension(), FPackageName::GetMapPackageExtension() })
+	{
+		if(!FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), PackageFilename, PackageExtension)) break;
+
+		PackageTimeStamp = IFileManager::Get().GetTimeStamp(*PackageFilename);
+
+		if(PackageTimeStamp != FDateTime::MinValue()) break;
+	}
+
+	PackageTimeStamps.Add(PackageName, PackageTimeStamp);
+
+	return PackageTimeStamp;
+}
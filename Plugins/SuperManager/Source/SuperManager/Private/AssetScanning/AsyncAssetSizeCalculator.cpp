@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetScanning/AsyncAssetSizeCalculator.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+
+void FAsyncAssetSizeCalculator::Enqueue(TArray<FAssetSizeRequest>&& SizeRequests)
+{
+	if(SizeRequests.Num() == 0) return;
+
+	++NumPendingBatches;
+
+	//The task keeps the calculator alive, so the widget that enqueued the batch may close at any time
+	Async(EAsyncExecution::ThreadPool, [Calculator = AsShared(), SizeRequests = MoveTemp(SizeRequests)]()
+	{
+		Calculator->CalculateOnWorkerThread(SizeRequests);
+		--Calculator->NumPendingBatches;
+	});
+}
+
+void FAsyncAssetSizeCalculator::Cancel()
+{
+	bCancelRequested = true;
+}
+
+int32 FAsyncAssetSizeCalculator::ConsumeSizeResults(TArray<FAssetSizeResult>& OutSizeResults)
+{
+	FScopeLock FinishedSizeResultsScopeLock(&FinishedSizeResultsLock);
+
+	const int32 NumConsumedResults = FinishedSizeResults.Num();
+
+	OutSizeResults.Append(MoveTemp(FinishedSizeResults));
+	FinishedSizeResults.Reset();
+
+	return NumConsumedResults;
+}
+
+void FAsyncAssetSizeCalculator::CalculateOnWorkerThread(const TArray<FAssetSizeRequest>& SizeRequests)
+{
+	if(bCancelRequested) return;
+
+	TArray<FAssetSizeResult> SizeResults;
+	SizeResults.SetNum(SizeRequests.Num());
+
+	//File stats dominate, they are independent per asset and spread over every worker
+	ParallelFor(SizeRequests.Num(), [&](int32 RequestIndex)
+	{
+		if(bCancelRequested) return;
+
+		const FAssetSizeRequest& SizeRequest = SizeRequests[RequestIndex];
+		FAssetSizeResult& SizeResult = SizeResults[RequestIndex];
+
+		SizeResult.ItemIndex = SizeRequest.ItemIndex;
+		SizeResult.DiskSize = GetPackageFileSize(SizeRequest.AssetData.PackageName);
+		SizeResult.MemorySize = GetRegistryResourceSize(SizeRequest.AssetData);
+	});
+
+	if(bCancelRequested) return;
+
+	FScopeLock FinishedSizeResultsScopeLock(&FinishedSizeResultsLock);
+	FinishedSizeResults.Append(MoveTemp(SizeResults));
+}
+
+int64 FAsyncAssetSizeCalculator::GetPackageFileSize(FName PackageName)
+{
+	FString PackageFilename;
+
+	//Asset packages are far more common than maps, so maps cost the second stat
+	for(const FString& PackageExtension : { FPackageName::GetAssetPackageExtension(), FPackageName::GetMapPackageExtension() })
+	{
+		if(!FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), PackageFilename, PackageExtension)) break;
+
+		const int64 PackageFileSize = IFileManager::Get().FileSize(*PackageFilename);
+
+		if(PackageFileSize >= 0) return PackageFileSize;
+	}
+
+	return -1;
+}
+
+int64 FAsyncAssetSizeCalculator::GetRegistryResourceSize(const FAssetData& AssetData)
+{
+	int64 ResourceSize = -1;
+
+	if(!AssetData.GetTagValue(FName(TEXT("ResourceSize")), ResourceSize))
+	{
+		return -1;
+	}
+
+	return ResourceSize;
+}
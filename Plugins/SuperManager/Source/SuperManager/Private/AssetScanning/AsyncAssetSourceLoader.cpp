@@ -0,0 +1,178 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetScanning/AsyncAssetSourceLoader.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectGlobals.h"
+
+//Loaded packages waiting to be read count against this too, so at most this many are held at a time
+#define AssetSourceMaxLoadsInFlight 8
+
+//Collecting garbage stalls the editor, so released packages are collected in batches
+#define AssetSourceReleasesPerCollection 64
+
+//Hard imports of the package that are not loaded yet, followed recursively, loading the package loads all of them
+static void GatherUnloadedImportPackages(FName PackageName, TArray<FName>& OutPackageNames)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TSet<FName> VisitedPackageNames;
+	VisitedPackageNames.Add(PackageName);
+
+	TArray<FName> PackagesToVisit;
+	PackagesToVisit.Add(PackageName);
+
+	while(PackagesToVisit.Num() > 0)
+	{
+		const FName VisitedPackageName = PackagesToVisit.Pop(EAllowShrinking::No);
+
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(VisitedPackageName, Dependencies,
+			UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+		for(const FName Dependency : Dependencies)
+		{
+			bool bAlreadyVisited = false;
+			VisitedPackageNames.Add(Dependency, &bAlreadyVisited);
+
+			//A loaded package already keeps its own imports loaded, so the walk stops there
+			if(bAlreadyVisited || FindObjectFast<UPackage>(nullptr, Dependency)) continue;
+
+			OutPackageNames.Add(Dependency);
+			PackagesToVisit.Add(Dependency);
+		}
+	}
+}
+
+void FAsyncAssetSourceLoader::Enqueue(int32 ItemIndex, const FAssetData& AssetData, const FIoHash& PackageSavedHash)
+{
+	bCancelRequested = false;
+
+	//An asset already in memory is in use, it is read as it is and left loaded
+	if(UObject* LoadedAsset = AssetData.FastGetAsset(false))
+	{
+		LoadedAssets.Add({ ItemIndex, LoadedAsset, PackageSavedHash, false });
+		return;
+	}
+
+	PendingLoads.Add({ ItemIndex, AssetData.GetSoftObjectPath(), PackageSavedHash });
+
+	StartPendingLoads();
+}
+
+void FAsyncAssetSourceLoader::Cancel()
+{
+	bCancelRequested = true;
+
+	PendingLoads.Empty();
+
+	for(const FLoadedAssetSource& LoadedAsset : LoadedAssets)
+	{
+		Release(LoadedAsset);
+	}
+
+	LoadedAssets.Empty();
+}
+
+int32 FAsyncAssetSourceLoader::ConsumeLoadedAssets(TArray<FLoadedAssetSource>& OutLoadedAssets, int32 MaxLoadedAssets)
+{
+	const int32 NumConsumedAssets = FMath::Min(MaxLoadedAssets, LoadedAssets.Num());
+
+	OutLoadedAssets.Append(LoadedAssets.GetData(), NumConsumedAssets);
+	LoadedAssets.RemoveAt(0, NumConsumedAssets, EAllowShrinking::No);
+
+	StartPendingLoads();
+
+	return NumConsumedAssets;
+}
+
+void FAsyncAssetSourceLoader::Release(const FLoadedAssetSource& LoadedAsset)
+{
+	if(!LoadedAsset.bLoadedByLoader) return;
+
+	if(UObject* Asset = LoadedAsset.Asset.Get())
+	{
+		ReleasePackage(Asset->GetPackage());
+	}
+
+	//Imports shared with an asset still being read stay referenced by it until that asset is released as well
+	for(const FName ImportPackageName : LoadedAsset.LoadedImportPackageNames)
+	{
+		if(UPackage* ImportPackage = FindObjectFast<UPackage>(nullptr, ImportPackageName))
+		{
+			ReleasePackage(ImportPackage);
+		}
+	}
+}
+
+void FAsyncAssetSourceLoader::ReleasePackage(UPackage* Package)
+{
+	//Edited since it was loaded, so the user is working with it
+	if(Package->IsDirty()) return;
+
+	ForEachObjectWithPackage(Package, [](UObject* Object)
+	{
+		Object->ClearFlags(RF_Standalone);
+		return true;
+	});
+
+	++NumReleasedPackages;
+}
+
+void FAsyncAssetSourceLoader::CollectReleasedPackages(bool bForce)
+{
+	if(NumReleasedPackages == 0 || (!bForce && NumReleasedPackages < AssetSourceReleasesPerCollection)) return;
+
+	NumReleasedPackages = 0;
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+void FAsyncAssetSourceLoader::StartPendingLoads()
+{
+	int32 NumStartedLoads = 0;
+
+	while(NumStartedLoads < PendingLoads.Num() && NumLoadsInFlight + LoadedAssets.Num() < AssetSourceMaxLoadsInFlight)
+	{
+		FPendingLoad PendingLoad = MoveTemp(PendingLoads[NumStartedLoads++]);
+
+		GatherUnloadedImportPackages(PendingLoad.AssetPath.GetLongPackageFName(), PendingLoad.UnloadedImportPackageNames);
+
+		++NumLoadsInFlight;
+
+		//The callback keeps the loader alive, so a package finishing after the widget closed is still released
+		LoadPackageAsync(PendingLoad.AssetPath.GetLongPackageName(), FLoadPackageAsyncDelegate::CreateLambda(
+			[Loader = AsShared(), PendingLoad](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+			{
+				--Loader->NumLoadsInFlight;
+
+				UObject* Asset = LoadedPackage && Result == EAsyncLoadingResult::Succeeded ? PendingLoad.AssetPath.ResolveObject() : nullptr;
+
+				FLoadedAssetSource LoadedAsset{ PendingLoad.ItemIndex, Asset, PendingLoad.PackageSavedHash, true };
+
+				//Imports loaded since the load started came with it, a failed load can still leave some of them loaded
+				for(const FName ImportPackageName : PendingLoad.UnloadedImportPackageNames)
+				{
+					if(FindObjectFast<UPackage>(nullptr, ImportPackageName))
+					{
+						LoadedAsset.LoadedImportPackageNames.Add(ImportPackageName);
+					}
+				}
+
+				//A failed load is still handed over, so the caller knows the asset cannot be read
+				if(Loader->bCancelRequested)
+				{
+					Loader->Release(LoadedAsset);
+				}
+				else
+				{
+					Loader->LoadedAssets.Add(LoadedAsset);
+				}
+			}));
+	}
+
+	PendingLoads.RemoveAt(0, NumStartedLoads, EAllowShrinking::No);
+}
@@ -0,0 +1,163 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetScanning/AsyncStaticMeshGeometryHasher.h"
+#include "Async/Async.h"
+#include "Algo/Sort.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSourceData.h"
+#include "Hash/xxhash.h"
+#include "StaticMeshAttributes.h"
+
+//Positions and UVs are rounded to these steps before hashing, so reimports with float noise still match
+#define GeometryHashPositionStep 0.001f
+#define GeometryHashUVStep (1.f / 65536.f)
+
+bool FStaticMeshGeometry::ReadFromStaticMesh(const UStaticMesh& StaticMesh)
+{
+	if(!StaticMesh.IsSourceModelValid(0)) return false;
+
+	const FStaticMeshSourceModel& SourceModel = StaticMesh.GetSourceModel(0);
+
+	//GetMeshDescription would cache the loaded description on the mesh for as long as the mesh lives
+	if(const FMeshDescription* CachedMeshDescription = SourceModel.GetCachedMeshDescription())
+	{
+		return ReadFromMeshDescription(*CachedMeshDescription);
+	}
+
+	FMeshDescription MeshDescription;
+
+	if(!SourceModel.LoadMeshDescription(MeshDescription)) return false;
+
+	return ReadFromMeshDescription(MeshDescription);
+}
+
+bool FStaticMeshGeometry::ReadFromMeshDescription(const FMeshDescription& MeshDescription)
+{
+	FStaticMeshConstAttributes MeshAttributes(MeshDescription);
+	TVertexAttributesConstRef<FVector3f> VertexPositions = MeshAttributes.GetVertexPositions();
+	TVertexInstanceAttributesConstRef<FVector2f> VertexInstanceUVs = MeshAttributes.GetVertexInstanceUVs();
+
+	NumUVChannels = VertexInstanceUVs.GetNumChannels();
+
+	const int32 NumCorners = MeshDescription.Triangles().Num() * 3;
+
+	CornerPositions.Reset(NumCorners);
+	CornerUVs.Reset(NumCorners * NumUVChannels);
+
+	for(const FTriangleID TriangleID : MeshDescription.Triangles().GetElementIDs())
+	{
+		for(const FVertexInstanceID VertexInstanceID : MeshDescription.GetTriangleVertexInstances(TriangleID))
+		{
+			CornerPositions.Add(VertexPositions[MeshDescription.GetVertexInstanceVertex(VertexInstanceID)]);
+
+			for(int32 UVChannel = 0; UVChannel < NumUVChannels; ++UVChannel)
+			{
+				CornerUVs.Add(VertexInstanceUVs.Get(VertexInstanceID, UVChannel));
+			}
+		}
+	}
+
+	//Meshes without triangles would all hash alike
+	return CornerPositions.Num() > 0;
+}
+
+void FAsyncStaticMeshGeometryHasher::Enqueue(int32 ItemIndex, FName PackageName, const FIoHash& PackageSavedHash, FStaticMeshGeometry&& Geometry)
+{
+	const int64 GeometryBytes = Geometry.CornerPositions.GetAllocatedSize() + Geometry.CornerUVs.GetAllocatedSize();
+
+	++NumPendingMeshes;
+	NumPendingGeometryBytes += GeometryBytes;
+
+	//The task keeps the hasher alive, so the widget that enqueued the mesh may close at any time
+	Async(EAsyncExecution::ThreadPool, [Hasher = AsShared(), ItemIndex, PackageName, PackageSavedHash, GeometryBytes, Geometry = MoveTemp(Geometry)]()
+	{
+		if(!Hasher->bCancelRequested)
+		{
+			FStaticMeshGeometryHashResult HashResult;
+			HashResult.ItemIndex = ItemIndex;
+			HashResult.PackageName = PackageName;
+			HashResult.PackageSavedHash = PackageSavedHash;
+			HashResult.GeometryHash = ComputeGeometryHash(Geometry);
+
+			FScopeLock FinishedHashResultsScopeLock(&Hasher->FinishedHashResultsLock);
+			Hasher->FinishedHashResults.Add(HashResult);
+		}
+
+		Hasher->NumPendingGeometryBytes -= GeometryBytes;
+		--Hasher->NumPendingMeshes;
+	});
+}
+
+void FAsyncStaticMeshGeometryHasher::Cancel()
+{
+	bCancelRequested = true;
+}
+
+int32 FAsyncStaticMeshGeometryHasher::ConsumeHashResults(TArray<FStaticMeshGeometryHashResult>& OutHashResults)
+{
+	FScopeLock FinishedHashResultsScopeLock(&FinishedHashResultsLock);
+
+	const int32 NumConsumedResults = FinishedHashResults.Num();
+
+	OutHashResults.Append(MoveTemp(FinishedHashResults));
+	FinishedHashResults.Reset();
+
+	return NumConsumedResults;
+}
+
+uint64 FAsyncStaticMeshGeometryHasher::ComputeGeometryHash(const FStaticMeshGeometry& Geometry)
+{
+	const int32 NumCorners = Geometry.CornerPositions.Num();
+	const int32 NumUVChannels = Geometry.NumUVChannels;
+
+	TArray<uint64> CornerHashes;
+	CornerHashes.SetNumUninitialized(NumCorners);
+
+	TArray<int32, TInlineAllocator<64>> QuantizedCorner;
+
+	for(int32 CornerIndex = 0; CornerIndex < NumCorners; ++CornerIndex)
+	{
+		const FVector3f& Position = Geometry.CornerPositions[CornerIndex];
+
+		QuantizedCorner.Reset();
+		QuantizedCorner.Add(FMath::RoundToInt32(Position.X / GeometryHashPositionStep));
+		QuantizedCorner.Add(FMath::RoundToInt32(Position.Y / GeometryHashPositionStep));
+		QuantizedCorner.Add(FMath::RoundToInt32(Position.Z / GeometryHashPositionStep));
+
+		for(int32 UVChannel = 0; UVChannel < NumUVChannels; ++UVChannel)
+		{
+			const FVector2f& UV = Geometry.CornerUVs[CornerIndex * NumUVChannels + UVChannel];
+
+			QuantizedCorner.Add(FMath::RoundToInt32(UV.X / GeometryHashUVStep));
+			QuantizedCorner.Add(FMath::RoundToInt32(UV.Y / GeometryHashUVStep));
+		}
+
+		CornerHashes[CornerIndex] = FXxHash64::HashBuffer(QuantizedCorner.GetData(), QuantizedCorner.Num() * sizeof(int32)).Hash;
+	}
+
+	//Rotating keeps the winding, so a flipped triangle still hashes differently
+	TArray<uint64> TriangleHashes;
+	TriangleHashes.SetNumUninitialized(NumCorners / 3);
+
+	for(int32 TriangleIndex = 0; TriangleIndex < TriangleHashes.Num(); ++TriangleIndex)
+	{
+		const uint64* Corners = &CornerHashes[TriangleIndex * 3];
+
+		int32 FirstCorner = 0;
+		if(Corners[1] < Corners[FirstCorner]) FirstCorner = 1;
+		if(Corners[2] < Corners[FirstCorner]) FirstCorner = 2;
+
+		const uint64 RotatedCorners[3] = { Corners[FirstCorner], Corners[(FirstCorner + 1) % 3], Corners[(FirstCorner + 2) % 3] };
+
+		TriangleHashes[TriangleIndex] = FXxHash64::HashBuffer(RotatedCorners, sizeof(RotatedCorners)).Hash;
+	}
+
+	Algo::Sort(TriangleHashes);
+
+	FXxHash64Builder HashBuilder;
+	HashBuilder.Update(&NumUVChannels, sizeof(NumUVChannels));
+	HashBuilder.Update(TriangleHashes.GetData(), TriangleHashes.Num() * sizeof(uint64));
+
+	return HashBuilder.Finalize().Hash;
+}
@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetScanning/AsyncTexturePerceptualHasher.h"
+#include "Async/Async.h"
+#include "Algo/Sort.h"
+#include "ImageCore.h"
+
+//Images are shrunk to this size before the DCT, and this many of the lowest frequencies per axis make up the hash
+#define PerceptualHashImageSize 32
+#define PerceptualHashFrequencies 8
+
+void FAsyncTexturePerceptualHasher::Enqueue(int32 ItemIndex, FName PackageName, const FIoHash& PackageSavedHash, FImage&& SourceImage)
+{
+	const int64 ImageBytes = SourceImage.GetImageSizeBytes();
+
+	++NumPendingImages;
+	NumPendingImageBytes += ImageBytes;
+
+	//The task keeps the hasher alive, so the widget that enqueued the image may close at any time
+	Async(EAsyncExecution::ThreadPool, [Hasher = AsShared(), ItemIndex, PackageName, PackageSavedHash, ImageBytes, SourceImage = MoveTemp(SourceImage)]()
+	{
+		if(!Hasher->bCancelRequested)
+		{
+			FTexturePerceptualHashResult HashResult;
+			HashResult.ItemIndex = ItemIndex;
+			HashResult.PackageName = PackageName;
+			HashResult.PackageSavedHash = PackageSavedHash;
+			HashResult.PerceptualHash = ComputePerceptualHash(SourceImage);
+
+			FScopeLock FinishedHashResultsScopeLock(&Hasher->FinishedHashResultsLock);
+			Hasher->FinishedHashResults.Add(HashResult);
+		}
+
+		Hasher->NumPendingImageBytes -= ImageBytes;
+		--Hasher->NumPendingImages;
+	});
+}
+
+void FAsyncTexturePerceptualHasher::Cancel()
+{
+	bCancelRequested = true;
+}
+
+int32 FAsyncTexturePerceptualHasher::ConsumeHashResults(TArray<FTexturePerceptualHashResult>& OutHashResults)
+{
+	FScopeLock FinishedHashResultsScopeLock(&FinishedHashResultsLock);
+
+	const int32 NumConsumedResults = FinishedHashResults.Num();
+
+	OutHashResults.Append(MoveTemp(FinishedHashResults));
+	FinishedHashResults.Reset();
+
+	return NumConsumedResults;
+}
+
+uint64 FAsyncTexturePerceptualHasher::ComputePerceptualHash(const FImage& SourceImage)
+{
+	//Linear color, so sources stored in different formats and gamma spaces compare alike
+	FImage SmallImage;
+	SourceImage.ResizeTo(SmallImage, PerceptualHashImageSize, PerceptualHashImageSize, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+
+	const TArrayView64<FLinearColor> SmallPixels = SmallImage.AsRGBA32F();
+
+	float Luminance[PerceptualHashImageSize][PerceptualHashImageSize];
+
+	for(int32 Y = 0; Y < PerceptualHashImageSize; ++Y)
+	{
+		for(int32 X = 0; X < PerceptualHashImageSize; ++X)
+		{
+			Luminance[Y][X] = SmallPixels[Y * PerceptualHashImageSize + X].GetLuminance();
+		}
+	}
+
+	//Only the lowest frequencies are kept, so both DCT passes stop after them
+	static const TArray<float> CosineTable = []()
+	{
+		TArray<float> Table;
+		Table.SetNum(PerceptualHashFrequencies * PerceptualHashImageSize);
+
+		for(int32 Frequency = 0; Frequency < PerceptualHashFrequencies; ++Frequency)
+		{
+			for(int32 Position = 0; Position < PerceptualHashImageSize; ++Position)
+			{
+				Table[Frequency * PerceptualHashImageSize + Position] =
+					FMath::Cos((2 * Position + 1) * Frequency * PI / (2 * PerceptualHashImageSize));
+			}
+		}
+
+		return Table;
+	}();
+
+	float RowFrequencies[PerceptualHashImageSize][PerceptualHashFrequencies];
+
+	for(int32 Y = 0; Y < PerceptualHashImageSize; ++Y)
+	{
+		for(int32 U = 0; U < PerceptualHashFrequencies; ++U)
+		{
+			float Sum = 0.f;
+
+			for(int32 X = 0; X < PerceptualHashImageSize; ++X)
+			{
+				Sum += Luminance[Y][X] * CosineTable[U * PerceptualHashImageSize + X];
+			}
+
+			RowFrequencies[Y][U] = Sum;
+		}
+	}
+
+	float Frequencies[PerceptualHashFrequencies * PerceptualHashFrequencies];
+
+	for(int32 V = 0; V < PerceptualHashFrequencies; ++V)
+	{
+		for(int32 U = 0; U < PerceptualHashFrequencies; ++U)
+		{
+			float Sum = 0.f;
+
+			for(int32 Y = 0; Y < PerceptualHashImageSize; ++Y)
+			{
+				Sum += RowFrequencies[Y][U] * CosineTable[V * PerceptualHashImageSize + Y];
+			}
+
+			Frequencies[V * PerceptualHashFrequencies + U] = Sum;
+		}
+	}
+
+	//The constant term only carries the average brightness and is left out of the median and the hash, it would set a bit
+	//that is almost always on and only narrow the range of distances
+	TArray<float, TInlineAllocator<PerceptualHashFrequencies * PerceptualHashFrequencies>> SortedFrequencies;
+	SortedFrequencies.Append(Frequencies + 1, PerceptualHashFrequencies * PerceptualHashFrequencies - 1);
+	Algo::Sort(SortedFrequencies);
+
+	const float MedianFrequency = SortedFrequencies[SortedFrequencies.Num() / 2];
+
+	uint64 PerceptualHash = 0;
+
+	for(int32 FrequencyIndex = 1; FrequencyIndex < PerceptualHashFrequencies * PerceptualHashFrequencies; ++FrequencyIndex)
+	{
+		if(Frequencies[FrequencyIndex] > MedianFrequency)
+		{
+			PerceptualHash |= 1ull << FrequencyIndex;
+		}
+	}
+
+	return PerceptualHash;
+}
+
+int32 FAsyncTexturePerceptualHasher::GetSourceMipToHash(int32 SizeX, int32 SizeY, int32 NumMips)
+{
+	int32 MipIndex = 0;
+
+	while(MipIndex + 1 < NumMips && (FMath::Min(SizeX, SizeY) >> (MipIndex + 1)) >= PerceptualHashImageSize)
+	{
+		++MipIndex;
+	}
+
+	return MipIndex;
+}
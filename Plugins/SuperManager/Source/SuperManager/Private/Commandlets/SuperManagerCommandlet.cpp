@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/SuperManagerCommandlet.h"
+#include "SuperManager.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSuperManagerCommandlet, Log, All);
+
+USuperManagerCommandlet::USuperManagerCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 USuperManagerCommandlet::Main(const FString& Params)
+{
+	FString ScanPath = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Path="), ScanPath);
+
+	FString ReportPath = FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("AuditReport");
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+	FString ReportFormat = TEXT("Both");
+	FParse::Value(*Params, TEXT("Format="), ReportFormat);
+
+	const bool bWriteJson = !ReportFormat.Equals(TEXT("Csv"), ESearchCase::IgnoreCase);
+	const bool bWriteCsv = !ReportFormat.Equals(TEXT("Json"), ESearchCase::IgnoreCase);
+
+	PhaseTimings.Empty();
+	PhaseStartTime = FPlatformTime::Seconds();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+	EndPhase(TEXT("AssetRegistryScan"));
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	//Reuses the graph built when the registry finished loading, only builds it when nothing has yet
+	SuperManagerModule.GetAssetReferenceGraph();
+	EndPhase(TEXT("ReferenceGraphBuild"));
+
+	TArray<FString> ScanFolderPaths;
+	ScanPath.ParseIntoArray(ScanFolderPaths, TEXT("+"));
+
+	TArray<FAssetData> AssetsData;
+	SuperManagerModule.GatherAssetDataUnderFolders(ScanFolderPaths, AssetsData);
+	EndPhase(TEXT("AssetListing"));
+
+	TArray<FAssetData> UnusedAssetsData;
+	SuperManagerModule.ScanForUnusedAssets(AssetsData, UnusedAssetsData);
+	EndPhase(TEXT("UnusedAssetScan"));
+
+	TArray<FString> EmptyFolderPaths;
+	SuperManagerModule.ListEmptyFoldersUnderFolders(ScanFolderPaths, EmptyFolderPaths);
+	EndPhase(TEXT("EmptyFolderScan"));
+
+	UE_LOG(LogSuperManagerCommandlet, Display, TEXT("Scanned %d assets under %s, %d unused assets, %d empty folders"),
+		AssetsData.Num(), *ScanPath, UnusedAssetsData.Num(), EmptyFolderPaths.Num());
+
+	if(bWriteCsv)
+	{
+		TUniquePtr<FArchive> CsvArchive(IFileManager::Get().CreateFileWriter(*(ReportPath + TEXT(".csv"))));
+
+		if(!CsvArchive)
+		{
+			UE_LOG(LogSuperManagerCommandlet, Error, TEXT("Failed to open %s.csv for writing"), *ReportPath);
+			return 1;
+		}
+
+		WriteCsvReport(*CsvArchive, UnusedAssetsData);
+		EndPhase(TEXT("CsvReportWrite"));
+	}
+
+	//The JSON report carries the timings of every phase before it, the CSV timings file also covers the JSON write
+	if(bWriteJson)
+	{
+		TUniquePtr<FArchive> JsonArchive(IFileManager::Get().CreateFileWriter(*(ReportPath + TEXT(".json"))));
+
+		if(!JsonArchive)
+		{
+			UE_LOG(LogSuperManagerCommandlet, Error, TEXT("Failed to open %s.json for writing"), *ReportPath);
+			return 1;
+		}
+
+		WriteJsonReport(*JsonArchive, ScanPath, UnusedAssetsData, EmptyFolderPaths, AssetsData.Num());
+		EndPhase(TEXT("JsonReportWrite"));
+	}
+
+	if(bWriteCsv)
+	{
+		TUniquePtr<FArchive> TimingsArchive(IFileManager::Get().CreateFileWriter(*(ReportPath + TEXT("_Timings.csv"))));
+
+		if(TimingsArchive)
+		{
+			WriteCsvTimings(*TimingsArchive);
+		}
+	}
+
+	return 0;
+}
+
+void USuperManagerCommandlet::EndPhase(const TCHAR* PhaseName)
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+
+	PhaseTimings.Emplace(PhaseName, CurrentTime - PhaseStartTime);
+
+	UE_LOG(LogSuperManagerCommandlet, Display, TEXT("%s took %.3f s"), PhaseName, CurrentTime - PhaseStartTime);
+
+	PhaseStartTime = CurrentTime;
+}
+
+#pragma region ReportWriting
+
+void USuperManagerCommandlet::WriteJsonReport(FArchive& ReportArchive, const FString& ScanPath,
+	const TArray<FAssetData>& UnusedAssetsData, const TArray<FString>& EmptyFolderPaths, int32 NumScannedAssets)
+{
+	int64 UnusedDiskSize = 0;
+
+	WriteUTF8(ReportArchive, FString::Printf(TEXT("{\n\t\"scanPath\": \"%s\",\n\t\"unusedAssets\": ["), *EscapeJsonString(ScanPath)));
+
+	for(int32 AssetIndex = 0; AssetIndex < UnusedAssetsData.Num(); ++AssetIndex)
+	{
+		const FAssetData& UnusedAssetData = UnusedAssetsData[AssetIndex];
+		const int64 DiskSize = GetPackageDiskSize(UnusedAssetData.PackageName);
+
+		UnusedDiskSize += FMath::Max<int64>(DiskSize, 0);
+
+		WriteUTF8(ReportArchive, FString::Printf(
+			TEXT("%s\n\t\t{\"path\": \"%s\", \"class\": \"%s\", \"diskSize\": %lld, \"referencerCount\": %d}"),
+			AssetIndex == 0 ? TEXT("") : TEXT(","),
+			*EscapeJsonString(UnusedAssetData.GetSoftObjectPath().ToString()),
+			*EscapeJsonString(UnusedAssetData.AssetClassPath.ToString()),
+			DiskSize,
+			GetPackageReferencerCount(UnusedAssetData.PackageName)));
+	}
+
+	WriteUTF8(ReportArchive, TEXT("\n\t],\n\t\"emptyFolders\": ["));
+
+	for(int32 FolderIndex = 0; FolderIndex < EmptyFolderPaths.Num(); ++FolderIndex)
+	{
+		WriteUTF8(ReportArchive, FString::Printf(TEXT("%s\n\t\t\"%s\""),
+			FolderIndex == 0 ? TEXT("") : TEXT(","), *EscapeJsonString(EmptyFolderPaths[FolderIndex])));
+	}
+
+	WriteUTF8(ReportArchive, FString::Printf(
+		TEXT("\n\t],\n\t\"summary\": {\"scannedAssets\": %d, \"unusedAssets\": %d, \"unusedDiskSize\": %lld, \"emptyFolders\": %d},\n\t\"timings\": {"),
+		NumScannedAssets, UnusedAssetsData.Num(), UnusedDiskSize, EmptyFolderPaths.Num()));
+
+	for(int32 PhaseIndex = 0; PhaseIndex < PhaseTimings.Num(); ++PhaseIndex)
+	{
+		WriteUTF8(ReportArchive, FString::Printf(TEXT("%s\"%s\": %.4f"),
+			PhaseIndex == 0 ? TEXT("") : TEXT(", "), *PhaseTimings[PhaseIndex].Key, PhaseTimings[PhaseIndex].Value));
+	}
+
+	WriteUTF8(ReportArchive, TEXT("}\n}\n"));
+}
+
+void USuperManagerCommandlet::WriteCsvReport(FArchive& ReportArchive, const TArray<FAssetData>& UnusedAssetsData)
+{
+	WriteUTF8(ReportArchive, TEXT("AssetPath,Class,DiskSize,ReferencerCount\n"));
+
+	for(const FAssetData& UnusedAssetData : UnusedAssetsData)
+	{
+		WriteUTF8(ReportArchive, FString::Printf(TEXT("%s,%s,%lld,%d\n"),
+			*EscapeCsvField(UnusedAssetData.GetSoftObjectPath().ToString()),
+			*EscapeCsvField(UnusedAssetData.AssetClassPath.ToString()),
+			GetPackageDiskSize(UnusedAssetData.PackageName),
+			GetPackageReferencerCount(UnusedAssetData.PackageName)));
+	}
+}
+
+void USuperManagerCommandlet::WriteCsvTimings(FArchive& TimingsArchive)
+{
+	WriteUTF8(TimingsArchive, TEXT("Phase,Seconds\n"));
+
+	for(const TPair<FString, double>& PhaseTiming : PhaseTimings)
+	{
+		WriteUTF8(TimingsArchive, FString::Printf(TEXT("%s,%.4f\n"), *PhaseTiming.Key, PhaseTiming.Value));
+	}
+}
+
+int64 USuperManagerCommandlet::GetPackageDiskSize(FName PackageName) const
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::GetModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const FAssetReferenceGraph& ReferenceGraph = SuperManagerModule.GetAssetReferenceGraph();
+
+	const int32 PackageIndex = ReferenceGraph.FindPackageIndex(PackageName);
+
+	return PackageIndex != INDEX_NONE ? ReferenceGraph.GetPackageDiskSize(PackageIndex) : -1;
+}
+
+int32 USuperManagerCommandlet::GetPackageReferencerCount(FName PackageName) const
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::GetModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const FAssetReferenceGraph& ReferenceGraph = SuperManagerModule.GetAssetReferenceGraph();
+
+	const int32 PackageIndex = ReferenceGraph.FindPackageIndex(PackageName);
+
+	//Package edges only, the same ones IsAssetUnreferenced decides on, so an unused asset always reports zero
+	return PackageIndex != INDEX_NONE ? ReferenceGraph.GetNumReferencers(PackageIndex, EPackageReferenceType::Package) : 0;
+}
+
+void USuperManagerCommandlet::WriteUTF8(FArchive& Archive, const FString& Text)
+{
+	const FTCHARToUTF8 ConvertedText(*Text);
+
+	Archive.Serialize(const_cast<ANSICHAR*>(ConvertedText.Get()), ConvertedText.Length());
+}
+
+FString USuperManagerCommandlet::EscapeJsonString(const FString& Text)
+{
+	FString EscapedText;
+	EscapedText.Reserve(Text.Len());
+
+	for(const TCHAR Character : Text)
+	{
+		if(Character == TEXT('\\') || Character == TEXT('"'))
+		{
+			EscapedText.AppendChar(TEXT('\\'));
+			EscapedText.AppendChar(Character);
+		}
+		else if(Character < 0x20)
+		{
+			EscapedText += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(Character));
+		}
+		else
+		{
+			EscapedText.AppendChar(Character);
+		}
+	}
+
+	return EscapedText;
+}
+
+FString USuperManagerCommandlet::EscapeCsvField(const FString& Field)
+{
+	if(!Field.Contains(TEXT(",")) && !Field.Contains(TEXT("\""))) return Field;
+
+	return TEXT("\"") + Field.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"");
+}
+
+#pragma endregion
@@ -0,0 +1,18 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Settings/SuperManagerSettings.h"
+
+USuperManagerSettings::USuperManagerSettings()
+{
+	CategoryName = TEXT("Plugins");
+	SectionName = TEXT("SuperManager");
+
+	FSuperManagerPathRule DevelopersRule;
+	DevelopersRule.Directory.Path = TEXT("/Game/Developers");
+	PathRules.Add(DevelopersRule);
+
+	FSuperManagerPathRule CollectionsRule;
+	CollectionsRule.Directory.Path = TEXT("/Game/Collections");
+	PathRules.Add(CollectionsRule);
+}
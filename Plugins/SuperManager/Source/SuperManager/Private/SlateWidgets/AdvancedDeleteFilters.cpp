@@ -0,0 +1,299 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SlateWidgets/AdvancedDeleteFilters.h"
+#include "SuperManager.h"
+#include "AssetScanning/AssetReferenceGraph.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Algo/StableSort.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture.h"
+#include "Materials/MaterialInterface.h"
+
+//Disk size above which the large asset filter lists an asset
+#define LargeAssetDiskSize (4ll * 1024 * 1024)
+
+#pragma region BuiltInFilters
+
+//Unreachable from the configured roots, the reachable set is marked once per graph change
+class FUnreachableAssetsFilter : public FAdvancedDeleteFilter
+{
+public:
+	FUnreachableAssetsFilter()
+		: FAdvancedDeleteFilter(AdvancedDeleteFilterIds::Unreachable, TEXT("Unreachable"), 2,
+			EAdvancedDeleteFilterInputs::ReferenceGraph | EAdvancedDeleteFilterInputs::ReferencePaths)
+	{
+	}
+
+	virtual void Prepare(const FAdvancedDeleteFilterContext& Context) override
+	{
+		FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+		SuperManagerModule.MarkReachablePackages(ReachablePackages);
+	}
+
+	virtual bool PassesFilter(const FAdvancedDeleteListItem& Item, const FAdvancedDeleteFilterContext& Context) const override
+	{
+		const int32 PackageIndex = Context.ReferenceGraph.FindPackageIndex(Item.AssetData.PackageName);
+
+		return PackageIndex != INDEX_NONE && !ReachablePackages[PackageIndex];
+	}
+
+private:
+	TBitArray<> ReachablePackages;
+};
+
+//Shares something with another stored asset, such as its name, the duplicates are found once per change of the stored items
+class FDuplicateAssetsFilter : public FAdvancedDeleteFilter
+{
+public:
+	using FListDuplicateAssets = void (FSuperManagerModule::*)(const TArray<TSharedPtr<FAdvancedDeleteListItem>>&,
+		TArray<TSharedPtr<FAdvancedDeleteListItem>>&);
+
+	FDuplicateAssetsFilter(FName InFilterId, const FString& InDisplayName, EAdvancedDeleteFilterInputs InInputs, FListDuplicateAssets InListDuplicateAssets)
+		: FAdvancedDeleteFilter(InFilterId, InDisplayName, 2, InInputs | EAdvancedDeleteFilterInputs::AllItems)
+		, ListDuplicateAssets(InListDuplicateAssets)
+	{
+	}
+
+	virtual void Prepare(const FAdvancedDeleteFilterContext& Context) override
+	{
+		FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+		TArray<TSharedPtr<FAdvancedDeleteListItem>> DuplicateItems;
+		(SuperManagerModule.*ListDuplicateAssets)(Context.AllItems, DuplicateItems);
+
+		DuplicateItemIndices.Init(false, Context.NumItemIndices);
+
+		for(const TSharedPtr<FAdvancedDeleteListItem>& DuplicateItem : DuplicateItems)
+		{
+			DuplicateItemIndices[DuplicateItem->ItemIndex] = true;
+		}
+	}
+
+	virtual bool PassesFilter(const FAdvancedDeleteListItem& Item, const FAdvancedDeleteFilterContext& Context) const override
+	{
+		return Item.ItemIndex < DuplicateItemIndices.Num() && DuplicateItemIndices[Item.ItemIndex];
+	}
+
+private:
+	FListDuplicateAssets ListDuplicateAssets;
+
+	TBitArray<> DuplicateItemIndices;
+};
+
+static TSharedRef<FAdvancedDeleteFilter> MakeClassFilter(FName FilterId, const FString& DisplayName, UClass* BaseClass)
+{
+	const FTopLevelAssetPath BaseClassPath = BaseClass->GetClassPathName();
+
+	//Derived classes are resolved once, testing an item is then a set lookup on its class path
+	TSet<FTopLevelAssetPath> ClassPaths;
+	IAssetRegistry::GetChecked().GetDerivedClassNames({ BaseClassPath }, {}, ClassPaths);
+	ClassPaths.Add(BaseClassPath);
+
+	return MakeShared<FAdvancedDeletePredicateFilter>(FilterId, DisplayName, 1, EAdvancedDeleteFilterInputs::AssetData,
+		[ClassPaths = MoveTemp(ClassPaths)](const FAdvancedDeleteListItem& Item, const FAdvancedDeleteFilterContext& Context)
+		{
+			return ClassPaths.Contains(Item.AssetData.AssetClassPath);
+		});
+}
+
+#pragma endregion
+
+void FAdvancedDeleteFilterPipeline::RegisterFilter(TSharedRef<FAdvancedDeleteFilter> Filter)
+{
+	RegisteredFilters.Emplace(Filter);
+}
+
+void FAdvancedDeleteFilterPipeline::RegisterBuiltInFilters()
+{
+	RegisterFilter(MakeShared<FAdvancedDeletePredicateFilter>(AdvancedDeleteFilterIds::Unused, TEXT("Unused"), 1, EAdvancedDeleteFilterInputs::ReferenceGraph,
+		[](const FAdvancedDeleteListItem& Item, const FAdvancedDeleteFilterContext& Context)
+		{
+			return Context.ReferenceGraph.IsAssetUnreferenced(Item.AssetData);
+		}));
+
+	RegisterFilter(MakeShared<FUnreachableAssetsFilter>());
+
+	RegisterFilter(MakeShared<FDuplicateAssetsFilter>(AdvancedDeleteFilterIds::SameName, TEXT("Same Name"),
+		EAdvancedDeleteFilterInputs::AssetData, &FSuperManagerModule::ListSameNameAssetsForAssetList));
+
+	//Items are only hashed once this filter is active, until their hash arrives they are not listed
+	RegisterFilter(MakeShared<FDuplicateAssetsFilter>(AdvancedDeleteFilterIds::SameContent, TEXT("Same Content"),
+		EAdvancedDeleteFilterInputs::ContentHashes, &FSuperManagerModule::ListSameContentAssetsForAssetList));
+
+	//Textures are loaded to read their source, so they are only hashed once this filter is active
+	RegisterFilter(MakeShared<FDuplicateAssetsFilter>(AdvancedDeleteFilterIds::SimilarTextures, TEXT("Similar Textures"),
+		EAdvancedDeleteFilterInputs::PerceptualHashes, &FSuperManagerModule::ListSimilarTexturesForAssetList));
+
+	//Static meshes are loaded to read their source model, so they are only hashed once this filter is active
+	RegisterFilter(MakeShared<FDuplicateAssetsFilter>(AdvancedDeleteFilterIds::SameGeometry, TEXT("Same Geometry"),
+		EAdvancedDeleteFilterInputs::GeometryHashes, &FSuperManagerModule::ListSameGeometryAssetsForAssetList));
+
+	RegisterFilter(MakeClassFilter(TEXT("Textures"), TEXT("Textures"), UTexture::StaticClass()));
+	RegisterFilter(MakeClassFilter(TEXT("StaticMeshes"), TEXT("Static Meshes"), UStaticMesh::StaticClass()));
+	RegisterFilter(MakeClassFilter(TEXT("Materials"), TEXT("Materials"), UMaterialInterface::StaticClass()));
+
+	RegisterFilter(MakeShared<FAdvancedDeletePredicateFilter>(TEXT("Large"), TEXT("Larger Than 4 MB"), 1, EAdvancedDeleteFilterInputs::AssetSizes,
+		[](const FAdvancedDeleteListItem& Item, const FAdvancedDeleteFilterContext& Context)
+		{
+			return Item.DiskSize > LargeAssetDiskSize;
+		}));
+}
+
+void FAdvancedDeleteFilterPipeline::SetFilterActive(int32 FilterIndex, bool bActive)
+{
+	RegisteredFilters[FilterIndex].bActive = bActive;
+}
+
+bool FAdvancedDeleteFilterPipeline::IsFilterActive(FName FilterId) const
+{
+	for(const FRegisteredFilter& RegisteredFilter : RegisteredFilters)
+	{
+		if(RegisteredFilter.Filter->GetFilterId() == FilterId) return RegisteredFilter.bActive;
+	}
+
+	return false;
+}
+
+FText FAdvancedDeleteFilterPipeline::GetActiveFiltersText() const
+{
+	TArray<FText> ActiveFilterNames;
+
+	for(const FRegisteredFilter& RegisteredFilter : RegisteredFilters)
+	{
+		if(RegisteredFilter.bActive) ActiveFilterNames.Add(RegisteredFilter.Filter->GetDisplayName());
+	}
+
+	if(ActiveFilterNames.Num() == 0) return FText::FromString(TEXT("All Assets"));
+
+	return FText::Join(FText::FromString(TEXT(" AND ")), ActiveFilterNames);
+}
+
+bool FAdvancedDeleteFilterPipeline::DoActiveFiltersRead(EAdvancedDeleteFilterInputs Inputs) const
+{
+	for(const FRegisteredFilter& RegisteredFilter : RegisteredFilters)
+	{
+		if(RegisteredFilter.bActive && EnumHasAnyFlags(RegisteredFilter.Filter->GetInputs(), Inputs)) return true;
+	}
+
+	return false;
+}
+
+void FAdvancedDeleteFilterPipeline::InvalidateInputs(EAdvancedDeleteFilterInputs ChangedInputs)
+{
+	for(FRegisteredFilter& RegisteredFilter : RegisteredFilters)
+	{
+		if(EnumHasAnyFlags(RegisteredFilter.Filter->GetInputs(), ChangedInputs))
+		{
+			ResetMemoizedResults(RegisteredFilter);
+		}
+	}
+}
+
+void FAdvancedDeleteFilterPipeline::InvalidateItem(int32 ItemIndex)
+{
+	for(FRegisteredFilter& RegisteredFilter : RegisteredFilters)
+	{
+		if(EnumHasAnyFlags(RegisteredFilter.Filter->GetInputs(), EAdvancedDeleteFilterInputs::AllItems))
+		{
+			ResetMemoizedResults(RegisteredFilter);
+		}
+		else if(ItemIndex < RegisteredFilter.EvaluatedItems.Num())
+		{
+			RegisteredFilter.EvaluatedItems[ItemIndex] = false;
+		}
+	}
+}
+
+void FAdvancedDeleteFilterPipeline::InvalidateItemInputs(int32 ItemIndex, EAdvancedDeleteFilterInputs ChangedInputs)
+{
+	for(FRegisteredFilter& RegisteredFilter : RegisteredFilters)
+	{
+		if(!EnumHasAnyFlags(RegisteredFilter.Filter->GetInputs(), ChangedInputs)) continue;
+
+		if(EnumHasAnyFlags(RegisteredFilter.Filter->GetInputs(), EAdvancedDeleteFilterInputs::AllItems | EAdvancedDeleteFilterInputs::ReferencePaths))
+		{
+			ResetMemoizedResults(RegisteredFilter);
+		}
+		else if(ItemIndex < RegisteredFilter.EvaluatedItems.Num())
+		{
+			RegisteredFilter.EvaluatedItems[ItemIndex] = false;
+		}
+	}
+}
+
+void FAdvancedDeleteFilterPipeline::ResetMemoizedResults(FRegisteredFilter& RegisteredFilter)
+{
+	//Results are only memoized after preparing, so an unprepared filter has nothing to reset
+	if(!RegisteredFilter.bPrepared) return;
+
+	RegisteredFilter.bPrepared = false;
+	RegisteredFilter.EvaluatedItems.SetRange(0, RegisteredFilter.EvaluatedItems.Num(), false);
+}
+
+void FAdvancedDeleteFilterPipeline::Evaluate(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToFilter,
+	const FAdvancedDeleteFilterContext& Context, TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutPassingItems)
+{
+	TArray<FRegisteredFilter*> ActiveFilters;
+
+	for(FRegisteredFilter& RegisteredFilter : RegisteredFilters)
+	{
+		if(!RegisteredFilter.bActive) continue;
+
+		ActiveFilters.Add(&RegisteredFilter);
+
+		//Items added since the last pass have no memoized results yet
+		const int32 NumNewItemIndices = Context.NumItemIndices - RegisteredFilter.EvaluatedItems.Num();
+
+		if(NumNewItemIndices > 0)
+		{
+			RegisteredFilter.EvaluatedItems.Add(false, NumNewItemIndices);
+			RegisteredFilter.PassingItems.Add(false, NumNewItemIndices);
+		}
+	}
+
+	if(ActiveFilters.Num() == 0)
+	{
+		OutPassingItems.Append(ItemsToFilter);
+		return;
+	}
+
+	//Stable, so filters of equal cost keep their registration order
+	Algo::StableSortBy(ActiveFilters, [](const FRegisteredFilter* RegisteredFilter)
+	{
+		return RegisteredFilter->Filter->GetCost();
+	});
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& Item : ItemsToFilter)
+	{
+		const int32 ItemIndex = Item->ItemIndex;
+		bool bPassesAllFilters = true;
+
+		for(FRegisteredFilter* ActiveFilter : ActiveFilters)
+		{
+			if(!ActiveFilter->EvaluatedItems[ItemIndex])
+			{
+				//Preparing waits for the first item actually needing the filter, fully memoized filters never prepare again
+				if(!ActiveFilter->bPrepared)
+				{
+					ActiveFilter->Filter->Prepare(Context);
+					ActiveFilter->bPrepared = true;
+				}
+
+				ActiveFilter->EvaluatedItems[ItemIndex] = true;
+				ActiveFilter->PassingItems[ItemIndex] = ActiveFilter->Filter->PassesFilter(*Item, Context);
+			}
+
+			if(!ActiveFilter->PassingItems[ItemIndex])
+			{
+				bPassesAllFilters = false;
+				break;
+			}
+		}
+
+		if(bPassesAllFilters)
+		{
+			OutPassingItems.Add(Item);
+		}
+	}
+}
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SlateWidgets/AdvancedDeleteFolderTree.h"
+#include "SlateWidgets/AdvancedDeleteListItem.h"
+#include "AssetScanning/AssetReferenceGraph.h"
+
+void FAdvancedDeleteFolderTree::Build(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items,
+	const FAssetReferenceGraph& ReferenceGraph)
+{
+	Reset();
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& Item : Items)
+	{
+		AddItem(*Item, 1, ReferenceGraph.IsAssetUnreferenced(Item->AssetData));
+	}
+}
+
+void FAdvancedDeleteFolderTree::Reset()
+{
+	Nodes.Reset();
+	NodeIndexMap.Reset();
+	FirstRootIndex = INDEX_NONE;
+}
+
+void FAdvancedDeleteFolderTree::AddItem(const FAdvancedDeleteListItem& Item, int32 Sign, bool bIsUnused)
+{
+	const int64 DiskSize = FMath::Max<int64>(Item.DiskSize, 0) * Sign;
+	const int64 MemorySize = FMath::Max<int64>(Item.MemorySize, 0) * Sign;
+
+	//Folders are only ever added, a folder whose items are all taken back stays in with empty totals
+	for(int32 NodeIndex = FindOrAddNode(Item.AssetData.PackagePath); NodeIndex != INDEX_NONE; NodeIndex = Nodes[NodeIndex].ParentIndex)
+	{
+		FAdvancedDeleteFolderNode& Node = Nodes[NodeIndex];
+
+		Node.NumAssets += Sign;
+		Node.DiskSize += DiskSize;
+		Node.MemorySize += MemorySize;
+
+		if(bIsUnused)
+		{
+			Node.NumUnusedAssets += Sign;
+		}
+	}
+}
+
+int32 FAdvancedDeleteFolderTree::FindNodeIndex(FName FolderPath) const
+{
+	const int32* NodeIndex = NodeIndexMap.Find(FolderPath);
+
+	return NodeIndex ? *NodeIndex : INDEX_NONE;
+}
+
+void FAdvancedDeleteFolderTree::GetRootNodeIndices(TArray<int32>& OutNodeIndices) const
+{
+	OutNodeIndices.Reset();
+
+	for(int32 NodeIndex = FirstRootIndex; NodeIndex != INDEX_NONE; NodeIndex = Nodes[NodeIndex].NextSiblingIndex)
+	{
+		OutNodeIndices.Add(NodeIndex);
+	}
+}
+
+void FAdvancedDeleteFolderTree::GetChildNodeIndices(int32 NodeIndex, TArray<int32>& OutNodeIndices) const
+{
+	OutNodeIndices.Reset();
+
+	for(int32 ChildIndex = Nodes[NodeIndex].FirstChildIndex; ChildIndex != INDEX_NONE; ChildIndex = Nodes[ChildIndex].NextSiblingIndex)
+	{
+		OutNodeIndices.Add(ChildIndex);
+	}
+}
+
+int32 FAdvancedDeleteFolderTree::FindOrAddNode(FName FolderPath)
+{
+	if(const int32* NodeIndex = NodeIndexMap.Find(FolderPath))
+	{
+		return *NodeIndex;
+	}
+
+	int32 ParentIndex = INDEX_NONE;
+
+	const FNameBuilder FolderPathBuilder(FolderPath);
+	const FStringView FolderPathView = FolderPathBuilder.ToView();
+
+	int32 LastSlashIndex = INDEX_NONE;
+
+	//The parent is added first, which is what keeps parents in front of their children
+	if(FolderPathView.FindLastChar(TEXT('/'), LastSlashIndex) && LastSlashIndex > 0)
+	{
+		ParentIndex = FindOrAddNode(FName(FolderPathView.Left(LastSlashIndex)));
+	}
+
+	const int32 NewNodeIndex = Nodes.AddDefaulted();
+	Nodes[NewNodeIndex].FolderPath = FolderPath;
+	Nodes[NewNodeIndex].ParentIndex = ParentIndex;
+
+	NodeIndexMap.Add(FolderPath, NewNodeIndex);
+	LinkNode(NewNodeIndex);
+
+	return NewNodeIndex;
+}
+
+void FAdvancedDeleteFolderTree::LinkNode(int32 NodeIndex)
+{
+	FAdvancedDeleteFolderNode& Node = Nodes[NodeIndex];
+
+	if(Node.ParentIndex == INDEX_NONE)
+	{
+		Node.NextSiblingIndex = FirstRootIndex;
+		FirstRootIndex = NodeIndex;
+		return;
+	}
+
+	FAdvancedDeleteFolderNode& ParentNode = Nodes[Node.ParentIndex];
+	Node.NextSiblingIndex = ParentNode.FirstChildIndex;
+	ParentNode.FirstChildIndex = NodeIndex;
+}
@@ -0,0 +1,163 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SlateWidgets/AdvancedDeleteSearchIndex.h"
+#include "String/Find.h"
+
+void FAdvancedDeleteSearchIndex::AddItem(int32 ItemIndex, FName AssetName, FName PackagePath)
+{
+	check(ItemIndex >= ItemAssetNames.Num());
+
+	ItemAssetNames.SetNum(ItemIndex + 1);
+	ItemPackagePaths.SetNum(ItemIndex + 1);
+	LiveItems.SetNum(ItemIndex + 1, false);
+
+	ItemAssetNames[ItemIndex] = AssetName;
+	ItemPackagePaths[ItemIndex] = PackagePath;
+	LiveItems[ItemIndex] = true;
+
+	const FNameBuilder AssetNameBuilder(AssetName);
+	const FNameBuilder PackagePathBuilder(PackagePath);
+
+	AddGramsOfText(ItemIndex, AssetNameBuilder.ToView());
+	AddGramsOfText(ItemIndex, PackagePathBuilder.ToView());
+}
+
+void FAdvancedDeleteSearchIndex::RemoveItem(int32 ItemIndex)
+{
+	if(LiveItems.IsValidIndex(ItemIndex))
+	{
+		LiveItems[ItemIndex] = false;
+	}
+}
+
+void FAdvancedDeleteSearchIndex::Reset()
+{
+	TrigramPostingLists.Empty();
+	ShortGramPostingLists.Empty();
+	ItemAssetNames.Empty();
+	ItemPackagePaths.Empty();
+	LiveItems.Empty();
+}
+
+void FAdvancedDeleteSearchIndex::Search(FStringView Query, TBitArray<>& OutMatchingItems) const
+{
+	OutMatchingItems.Init(false, LiveItems.Num());
+
+	if(Query.Len() == 0) return;
+
+	//A short query is its own gram, the list holds exactly the items containing it
+	if(Query.Len() < 3)
+	{
+		const FTrigramKey ShortGramKey = MakeTrigramKey(Query[0], Query.Len() > 1 ? Query[1] : 0, 0);
+
+		if(const TArray<int32>* ShortGramPostingList = ShortGramPostingLists.Find(ShortGramKey))
+		{
+			for(const int32 ItemIndex : *ShortGramPostingList)
+			{
+				OutMatchingItems[ItemIndex] = LiveItems[ItemIndex];
+			}
+		}
+
+		return;
+	}
+
+	TArray<const TArray<int32>*, TInlineAllocator<16>> QueryPostingLists;
+
+	for(int32 CharIndex = 0; CharIndex + 2 < Query.Len(); ++CharIndex)
+	{
+		const TArray<int32>* PostingList =
+			TrigramPostingLists.Find(MakeTrigramKey(Query[CharIndex], Query[CharIndex + 1], Query[CharIndex + 2]));
+
+		//A trigram no item contains, nothing can match
+		if(!PostingList) return;
+
+		QueryPostingLists.AddUnique(PostingList);
+	}
+
+	//Intersect from the shortest list, so the candidate set only ever shrinks
+	QueryPostingLists.Sort([](const TArray<int32>& A, const TArray<int32>& B)
+	{
+		return A.Num() < B.Num();
+	});
+
+	TArray<int32> Candidates = *QueryPostingLists[0];
+
+	for(int32 ListIndex = 1; ListIndex < QueryPostingLists.Num() && Candidates.Num() > 0; ++ListIndex)
+	{
+		const TArray<int32>& PostingList = *QueryPostingLists[ListIndex];
+
+		int32 NumKeptCandidates = 0;
+		int32 PostingIndex = 0;
+
+		for(const int32 Candidate : Candidates)
+		{
+			while(PostingIndex < PostingList.Num() && PostingList[PostingIndex] < Candidate) ++PostingIndex;
+
+			if(PostingIndex < PostingList.Num() && PostingList[PostingIndex] == Candidate)
+			{
+				Candidates[NumKeptCandidates++] = Candidate;
+			}
+		}
+
+		Candidates.SetNum(NumKeptCandidates, EAllowShrinking::No);
+	}
+
+	//Sharing every trigram does not guarantee the trigrams are contiguous, each candidate is checked against the text
+	for(const int32 Candidate : Candidates)
+	{
+		if(LiveItems[Candidate] && DoesItemMatch(Candidate, Query))
+		{
+			OutMatchingItems[Candidate] = true;
+		}
+	}
+}
+
+FAdvancedDeleteSearchIndex::FTrigramKey FAdvancedDeleteSearchIndex::MakeTrigramKey(TCHAR First, TCHAR Second, TCHAR Third)
+{
+	const FTrigramKey CharMask = 0x1FFFFF;
+
+	return ((FTrigramKey(FChar::ToLower(First)) & CharMask) << 42) |
+		((FTrigramKey(FChar::ToLower(Second)) & CharMask) << 21) |
+		(FTrigramKey(FChar::ToLower(Third)) & CharMask);
+}
+
+void FAdvancedDeleteSearchIndex::AddGramsOfText(int32 ItemIndex, FStringView Text)
+{
+	for(int32 CharIndex = 0; CharIndex < Text.Len(); ++CharIndex)
+	{
+		AddToPostingList(ShortGramPostingLists, MakeTrigramKey(Text[CharIndex], 0, 0), ItemIndex);
+
+		if(CharIndex + 1 < Text.Len())
+		{
+			AddToPostingList(ShortGramPostingLists, MakeTrigramKey(Text[CharIndex], Text[CharIndex + 1], 0), ItemIndex);
+		}
+
+		if(CharIndex + 2 < Text.Len())
+		{
+			AddToPostingList(TrigramPostingLists, MakeTrigramKey(Text[CharIndex], Text[CharIndex + 1], Text[CharIndex + 2]), ItemIndex);
+		}
+	}
+}
+
+void FAdvancedDeleteSearchIndex::AddToPostingList(TMap<FTrigramKey, TArray<int32>>& PostingLists, FTrigramKey Key, int32 ItemIndex)
+{
+	TArray<int32>& PostingList = PostingLists.FindOrAdd(Key);
+
+	//Items arrive in ascending order, so a repeated trigram of the same item is always the last entry
+	if(PostingList.Num() == 0 || PostingList.Last() != ItemIndex)
+	{
+		PostingList.Add(ItemIndex);
+	}
+}
+
+bool FAdvancedDeleteSearchIndex::DoesItemMatch(int32 ItemIndex, FStringView Query) const
+{
+	const FNameBuilder AssetNameBuilder(ItemAssetNames[ItemIndex]);
+
+	if(UE::String::FindFirst(AssetNameBuilder.ToView(), Query, ESearchCase::IgnoreCase) != INDEX_NONE) return true;
+
+	const FNameBuilder PackagePathBuilder(ItemPackagePaths[ItemIndex]);
+
+	return UE::String::FindFirst(PackagePathBuilder.ToView(), Query, ESearchCase::IgnoreCase) != INDEX_NONE;
+}
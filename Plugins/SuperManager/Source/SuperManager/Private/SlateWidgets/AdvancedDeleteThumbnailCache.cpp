@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SlateWidgets/AdvancedDeleteThumbnailCache.h"
+#include "SlateWidgets/AdvancedDeleteListItem.h"
+#include "AssetThumbnail.h"
+
+//Thumbnails are rendered into BGRA8 textures
+#define ThumbnailBytesPerPixel 4
+
+//Comfortably more than the rows a list can realize at once, so visible thumbnails are never evicted while shown
+#define MinCachedThumbnails 128
+
+static int32 GetMaxCachedThumbnails(int32 ThumbnailResolution, int64 MemoryBudget)
+{
+	const int64 ThumbnailSize = (int64)ThumbnailResolution * ThumbnailResolution * ThumbnailBytesPerPixel;
+
+	return (int32)FMath::Clamp<int64>(MemoryBudget / ThumbnailSize, MinCachedThumbnails, MAX_int32);
+}
+
+FAdvancedDeleteThumbnailCache::FAdvancedDeleteThumbnailCache(int32 InThumbnailResolution, int64 MemoryBudget)
+	: ThumbnailResolution(InThumbnailResolution)
+	, Thumbnails(GetMaxCachedThumbnails(InThumbnailResolution, MemoryBudget))
+{
+	//The pool keeps as many render targets as the cache keeps thumbnails, evicted thumbnails hand theirs back for reuse
+	ThumbnailPool = MakeShared<FAssetThumbnailPool>(Thumbnails.Max());
+}
+
+FAdvancedDeleteThumbnailCache::~FAdvancedDeleteThumbnailCache()
+{
+	Thumbnails.Empty();
+	ThumbnailPool.Reset();
+}
+
+TSharedRef<FAssetThumbnail> FAdvancedDeleteThumbnailCache::FindOrAddThumbnail(const FAdvancedDeleteListItem& Item)
+{
+	if(const TSharedPtr<FAssetThumbnail>* CachedThumbnail = Thumbnails.FindAndTouch(Item.ItemIndex))
+	{
+		return CachedThumbnail->ToSharedRef();
+	}
+
+	TSharedRef<FAssetThumbnail> NewThumbnail =
+		MakeShared<FAssetThumbnail>(Item.AssetData, ThumbnailResolution, ThumbnailResolution, ThumbnailPool);
+
+	Thumbnails.Add(Item.ItemIndex, NewThumbnail);
+
+	return NewThumbnail;
+}
+
+void FAdvancedDeleteThumbnailCache::RemoveThumbnail(int32 ItemIndex)
+{
+	Thumbnails.Remove(ItemIndex);
+}
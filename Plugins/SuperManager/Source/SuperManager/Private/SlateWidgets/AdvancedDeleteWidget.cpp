@@ -5,25 +5,108 @@
 
 #include "DebugHeader.h"
 #include "SuperManager.h"
-
-#define ListAll TEXT("List All Assets")
-#define ListUnused TEXT("List Unused Assets")
-#define ListSameName TEXT("List Assets With Same Name ")
+#include "AssetScanning/AsyncAssetDataGatherer.h"
+#include "AssetScanning/AsyncAssetSizeCalculator.h"
+#include "AssetScanning/AsyncAssetContentHasher.h"
+#include "AssetScanning/AsyncTexturePerceptualHasher.h"
+#include "AssetScanning/AsyncStaticMeshGeometryHasher.h"
+#include "AssetScanning/AsyncAssetSourceLoader.h"
+#include "SlateWidgets/AdvancedDeleteThumbnailCache.h"
+#include "SlateWidgets/AssetDeleteRow.h"
+#include "AssetThumbnail.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Widgets/Images/SThrobber.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/STreeView.h"
+#include "Widgets/Layout/SWidgetSwitcher.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Sort.h"
+#include "Engine/Texture2D.h"
+#include "Engine/StaticMesh.h"
+#include "ImageCore.h"
+
+//Gathered assets are streamed into the list at most this often, and at most this many per refresh
+#define StreamRefreshInterval 0.2f
+#define MaxStreamedAssetsPerRefresh 4096
+
+//Finished sizes are applied to the items at most this often
+#define SizePollInterval 0.25f
+
+//Finished content hashes are applied to the items at most this often
+#define ContentHashPollInterval 0.25f
+
+//Loaded texture sources are read for at most this long per tick, and not while this many bytes of them wait to be hashed
+#define TextureHashInterval 0.05f
+#define TextureHashTimeBudget 0.01
+#define TextureHashMaxPendingBytes (256ll * 1024 * 1024)
+
+//Loaded static mesh source models are read for at most this long per tick, and not while this many bytes of them wait to be hashed
+#define GeometryHashInterval 0.05f
+#define GeometryHashTimeBudget 0.01
+#define GeometryHashMaxPendingBytes (256ll * 1024 * 1024)
+
+//Typing only searches once the text has been left alone this long
+#define SearchDebounceDelay 0.15f
+
+//Thumbnails are rendered at this size and may use at most this much texture memory together
+static constexpr int32 ThumbnailRowResolution = 48;
+static constexpr int64 ThumbnailRowMemoryBudget = 32ll * 1024 * 1024;
+
+//The consolidate confirmation of a group lists at most this many of its duplicates
+#define ConsolidateConfirmMaxListedAssets 20
+
+//Registry changes are applied this long after the first one arrives, together with everything arriving meanwhile
+#define RegistryChangesApplyDelay 0.1f
 
 void SAdvancedDeleteTab::Construct(const FArguments& InArgs)
 {
 	bCanSupportFocus = true;
 
-	StoredAssetsData = InArgs._AssetsDataToStore;
-	DisplayedAssetsData = StoredAssetsData;
-	
-	CheckboxesArray.Empty();
-	AssetsDataToDeleteArray.Empty();
-	ComboBoxSourceItems.Empty();
+	AssetDataGatherer = InArgs._AssetDataGatherer;
+	ScanFolderPaths = InArgs._ScanFolderPaths;
+	SizeCalculator = MakeShared<FAsyncAssetSizeCalculator, ESPMode::ThreadSafe>();
+	FolderSizeTree.Reset();
+	ContentHasher.Reset();
+	bIsPollingContentHashResults = false;
+	TexturePerceptualHasher.Reset();
+	TextureSourceLoader.Reset();
+	bIsHashingTextures = false;
+	GeometryHasher.Reset();
+	GeometrySourceLoader.Reset();
+	bIsHashingGeometry = false;
+
+	StoredAssetsData.Empty();
+	ListedAssetsData.Empty();
+	DisplayedAssetsData.Empty();
+	AssetListRootItems.Empty();
+	DuplicateGroupMembers.Empty();
+
+	SearchIndex.Reset();
+	SearchText.Empty();
+
+	RowStyle = MakeShared<FAssetDeleteRowStyle>();
+	RecycledRows.Empty();
+	NumConstructedRows = 0;
+
+	bShowFolderTree = false;
+	bShowThumbnails = false;
+	FolderTreeRootItems.Empty();
+	ExpandedFolderPaths.Empty();
 	
-	ComboBoxSourceItems.Add(MakeShared<FString>(ListAll));
-	ComboBoxSourceItems.Add(MakeShared<FString>(ListUnused));
-	ComboBoxSourceItems.Add(MakeShared<FString>(ListSameName));
+	CheckedItems.Empty();
+	NextItemIndex = 0;
+	ItemsByAssetPath.Empty();
+	StoredItemsByPackageName.Empty();
+	StoredItemsByIndex.Empty();
+
+	//Items read their referencer counts when stored, changes recorded before the tab opened are already in them
+	TArray<FName> StaleReferencerCountChanges;
+	FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager")).ConsumeReferencerCountChanges(StaleReferencerCountChanges);
+	FilterPipeline = FAdvancedDeleteFilterPipeline();
+	FilterPipeline.RegisterBuiltInFilters();
+	ActiveFiltersText = FilterPipeline.GetActiveFiltersText();
 	
 	FSlateFontInfo TitleTextFont = GetEmbossedTextFont();
 	TitleTextFont.Size = 30.f;
@@ -52,7 +135,7 @@ void SAdvancedDeleteTab::Construct(const FArguments& InArgs)
 			+SHorizontalBox::Slot()
 			.AutoWidth()
 			[
-				ConstructComboBox()
+				ConstructFilterComboButton()
 			]
 
 			+SHorizontalBox::Slot()
@@ -70,16 +153,58 @@ void SAdvancedDeleteTab::Construct(const FArguments& InArgs)
 			]
 		]
 
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			ConstructGatheringProgressWidget()
+		]
+
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.f)
+		[
+			SNew(SHorizontalBox)
+
+			+SHorizontalBox::Slot()
+			.FillWidth(1.f)
+			[
+				ConstructSearchBox()
+			]
+
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(5.f, 0.f, 0.f, 0.f)
+			[
+				ConstructThumbnailToggle()
+			]
+
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(5.f, 0.f, 0.f, 0.f)
+			[
+				ConstructFolderTreeToggle()
+			]
+		]
+
 		//Third Slot
 		+SVerticalBox::Slot()
 		.VAlign(VAlign_Fill)
 		[
-			SNew(SScrollBox)
+			SNew(SWidgetSwitcher)
+			.WidgetIndex_Lambda([this]()
+			{
+				return bShowFolderTree ? 1 : 0;
+			})
 
-			+SScrollBox::Slot()
+			+SWidgetSwitcher::Slot()
 			[
 				ConstructAssetListView()
 			]
+
+			+SWidgetSwitcher::Slot()
+			[
+				ConstructFolderTreeView()
+			]
 		]
 		
 		//Fourth Slot
@@ -111,16 +236,90 @@ void SAdvancedDeleteTab::Construct(const FArguments& InArgs)
 			[
 				ConstructDeselectAllButton()
 			]
+
+			//Consolidate Button
+			+SHorizontalBox::Slot()
+			.FillWidth(10.f)
+			.Padding(5.f)
+			[
+				ConstructConsolidateButton()
+			]
 		]
 	];
+
+	if(AssetDataGatherer.IsValid())
+	{
+		RegisterActiveTimer(StreamRefreshInterval,
+			FWidgetActiveTimerDelegate::CreateSP(this, &SAdvancedDeleteTab::OnStreamGatheredAssets));
+
+		StartPollingSizeResults();
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	AssetRegistry.OnAssetAdded().AddSP(this, &SAdvancedDeleteTab::OnAssetAddedToRegistry);
+	AssetRegistry.OnAssetRemoved().AddSP(this, &SAdvancedDeleteTab::OnAssetRemovedFromRegistry);
+	AssetRegistry.OnAssetRenamed().AddSP(this, &SAdvancedDeleteTab::OnAssetRenamedInRegistry);
+	AssetRegistry.OnAssetUpdated().AddSP(this, &SAdvancedDeleteTab::OnAssetUpdatedInRegistry);
+}
+
+SAdvancedDeleteTab::~SAdvancedDeleteTab()
+{
+	if(FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+		AssetRegistry.OnAssetUpdated().RemoveAll(this);
+	}
+
+	if(AssetDataGatherer.IsValid())
+	{
+		AssetDataGatherer->Cancel();
+	}
+
+	if(SizeCalculator.IsValid())
+	{
+		SizeCalculator->Cancel();
+	}
+
+	if(ContentHasher.IsValid())
+	{
+		ContentHasher->Cancel();
+	}
+
+	if(TexturePerceptualHasher.IsValid())
+	{
+		TexturePerceptualHasher->Cancel();
+	}
+
+	if(TextureSourceLoader.IsValid())
+	{
+		TextureSourceLoader->Cancel();
+	}
+
+	if(GeometryHasher.IsValid())
+	{
+		GeometryHasher->Cancel();
+	}
+
+	if(GeometrySourceLoader.IsValid())
+	{
+		GeometrySourceLoader->Cancel();
+	}
 }
 
-TSharedRef<SListView<TSharedPtr<FAssetData>>> SAdvancedDeleteTab::ConstructAssetListView()
+TSharedRef<STreeView<TSharedPtr<FAdvancedDeleteListItem>>> SAdvancedDeleteTab::ConstructAssetListView()
 {
-	ConstructedAssetListView = SNew(SListView<TSharedPtr<FAssetData>>)
+	ConstructedAssetListView = SNew(STreeView<TSharedPtr<FAdvancedDeleteListItem>>)
 	.ItemHeight(24.f)
-	.ListItemsSource(&DisplayedAssetsData)
+	.TreeItemsSource(&AssetListRootItems)
+	.HeaderRow(ConstructHeaderRow())
 	.OnGenerateRow(this, &SAdvancedDeleteTab::OnGenerateRowForList)
+	.OnGetChildren(this, &SAdvancedDeleteTab::OnGetAssetListChildren)
+	.OnRowReleased(this, &SAdvancedDeleteTab::OnAssetRowReleased)
 	.OnMouseButtonClick(this, &SAdvancedDeleteTab::OnRowWidgetMouseButtonClicked);
 
 	return ConstructedAssetListView.ToSharedRef();
@@ -128,8 +327,7 @@ TSharedRef<SListView<TSharedPtr<FAssetData>>> SAdvancedDeleteTab::ConstructAsset
 
 void SAdvancedDeleteTab::RefreshAssetListView()
 {
-	CheckboxesArray.Empty();
-	AssetsDataToDeleteArray.Empty();
+	CheckedItems.SetRange(0, CheckedItems.Num(), false);
 	
 	if(ConstructedAssetListView.IsValid())
 	{
@@ -137,319 +335,2075 @@ void SAdvancedDeleteTab::RefreshAssetListView()
 	}
 }
 
-#pragma region ComboBoxForListingCondition
-
-TSharedRef<SComboBox<TSharedPtr<FString>>> SAdvancedDeleteTab::ConstructComboBox()
+TSharedPtr<FAdvancedDeleteListItem> SAdvancedDeleteTab::AddStoredItem(FGatheredAssetData&& GatheredAssetData,
+	const FAssetReferenceGraph& ReferenceGraph)
 {
-	TSharedRef<SComboBox<TSharedPtr<FString>>> ConstructedComboBox = SNew(SComboBox<TSharedPtr<FString>>)
-	.OptionsSource(&ComboBoxSourceItems)
-	.OnGenerateWidget(this, &SAdvancedDeleteTab::OnGenerateComboContent)
-	.OnSelectionChanged(this, &SAdvancedDeleteTab::OnComboSelectionChanged)
-	[
-		SAssignNew(ComboDisplayTextBlock,STextBlock)
-		.Text(FText::FromString(TEXT("List Assets Option")))
-	];
-
-	return ConstructedComboBox;
-}
+	const FSoftObjectPath AssetPath = GatheredAssetData.AssetData.GetSoftObjectPath();
 
-TSharedRef<SWidget> SAdvancedDeleteTab::OnGenerateComboContent(TSharedPtr<FString> SourceItem)
-{
-	TSharedRef<STextBlock> ConstructedComboText = SNew(STextBlock)
-	.Text(FText::FromString(*SourceItem.Get()));
+	if(ItemsByAssetPath.Contains(AssetPath)) return nullptr;
 
-	return ConstructedComboText;
-}
+	TSharedPtr<FAdvancedDeleteListItem> NewItem =
+		MakeShared<FAdvancedDeleteListItem>(MoveTemp(GatheredAssetData.AssetData), NextItemIndex++);
 
-void SAdvancedDeleteTab::OnComboSelectionChanged(TSharedPtr<FString> SelectedOption, ESelectInfo::Type InSelectInfo)
-{
+	NewItem->LastModified = GatheredAssetData.PackageTimeStamp;
 
-	ComboDisplayTextBlock->SetText(FText::FromString(*SelectedOption.Get()));
+	const int32 PackageIndex = ReferenceGraph.FindPackageIndex(NewItem->AssetData.PackageName);
 
-	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
-	
-	if(*SelectedOption.Get() == ListAll)
+	//Package edges only, the ones the Unused filter decides on, so an unused asset never shows referencers
+	if(PackageIndex != INDEX_NONE)
 	{
-		DisplayedAssetsData = StoredAssetsData;
-		RefreshAssetListView();
-	}
-	else if(*SelectedOption.Get() == ListUnused)
-	{
-		SuperManagerModule.ListUnusedAssetsForAssetList(StoredAssetsData, DisplayedAssetsData);
-		RefreshAssetListView();
-	}
-	else if(*SelectedOption.Get() == ListSameName)
-	{
-		SuperManagerModule.ListSameNameAssetsForAssetList(StoredAssetsData, DisplayedAssetsData);
-		RefreshAssetListView();
+		NewItem->ReferencerCount = ReferenceGraph.GetNumReferencers(PackageIndex, EPackageReferenceType::Package);
 	}
+
+	CheckedItems.Add(false);
+	StoredItemsByIndex.Add(NewItem.Get());
+	StoredAssetsData.Add(NewItem);
+	ItemsByAssetPath.Add(AssetPath, NewItem);
+	StoredItemsByPackageName.Add(NewItem->AssetData.PackageName, NewItem);
+
+	SearchIndex.AddItem(NewItem->ItemIndex, NewItem->AssetData.AssetName, NewItem->AssetData.PackagePath);
+
+	return NewItem;
 }
 
-TSharedRef<STextBlock> SAdvancedDeleteTab::ConstructComboHelpTexts(const FString& TextContent,
-	ETextJustify::Type TextJustify)
+int32 SAdvancedDeleteTab::RemoveStoredItems(const TSet<FSoftObjectPath>& RemovedAssetPaths)
 {
-	TSharedRef<STextBlock> ConstructedHelpText = SNew(STextBlock)
-	.Text(FText::FromString(TextContent))
-	.Justification(TextJustify)
-	.AutoWrapText(true);
+	//Removed items are looked up once, the compaction passes below only test a bit
+	TBitArray<> RemovedItems(false, NextItemIndex);
+	int32 NumRemovedItems = 0;
 
-	return ConstructedHelpText;
-}
+	for(const FSoftObjectPath& RemovedAssetPath : RemovedAssetPaths)
+	{
+		TSharedPtr<FAdvancedDeleteListItem> RemovedItem;
 
-#pragma endregion
+		if(!ItemsByAssetPath.RemoveAndCopyValue(RemovedAssetPath, RemovedItem)) continue;
 
-#pragma region RowWidgetForAssetListView
+		StoredItemsByPackageName.RemoveSingle(RemovedItem->AssetData.PackageName, RemovedItem);
 
-TSharedRef<ITableRow> SAdvancedDeleteTab::OnGenerateRowForList(TSharedPtr<FAssetData> AssetDataToDisplay,
-                                                               const TSharedRef<STableViewBase>& OwnerTable)
-{
-	if(!AssetDataToDisplay.IsValid()) return SNew(STableRow<TSharedPtr<FAssetData>>, OwnerTable);
+		RemovedItems[RemovedItem->ItemIndex] = true;
+		CheckedItems[RemovedItem->ItemIndex] = false;
+		StoredItemsByIndex[RemovedItem->ItemIndex] = nullptr;
+		SearchIndex.RemoveItem(RemovedItem->ItemIndex);
 
-	const FString DisplayAssetClassName = AssetDataToDisplay->AssetClassPath.GetAssetName().ToString();
-	const FString DisplayName = AssetDataToDisplay->AssetName.ToString();
+		if(RemovedItem->bSizesCalculated)
+		{
+			FolderSizeTree.AddItem(*RemovedItem, -1);
+		}
 
-	FSlateFontInfo AssetClassNameFont = GetEmbossedTextFont();
-	AssetClassNameFont.Size = 10.f;
+		if(ThumbnailCache.IsValid())
+		{
+			ThumbnailCache->RemoveThumbnail(RemovedItem->ItemIndex);
+		}
 
-	FSlateFontInfo AssetNameFont = GetEmbossedTextFont();
-	AssetNameFont.Size = 15.f;
-	
-	
-	TSharedRef<STableRow<TSharedPtr<FAssetData>>> ListViewRowWidget =
-		SNew(STableRow<TSharedPtr<FAssetData>>, OwnerTable).Padding(FMargin(5.f))
-	[
-		//First Slot
-		SNew(SHorizontalBox)
+		++NumRemovedItems;
+	}
 
-		+SHorizontalBox::Slot()
-		.HAlign(HAlign_Left)
-		.VAlign(VAlign_Center)
-		.FillWidth(.05f)
-		[
-			ConstructCheckBox(AssetDataToDisplay)
-		]
-		//Second Slot
-		+SHorizontalBox::Slot()
-		.HAlign(HAlign_Center)
-		.VAlign(VAlign_Fill)
-		.FillWidth(.55f)
-		[
-			ConstructTextForRowWidget(DisplayAssetClassName, AssetClassNameFont)
-		]
-		
-		//Third Slot
-		+SHorizontalBox::Slot()
-		.HAlign(HAlign_Left)
-		.VAlign(VAlign_Fill)
-		[
-			ConstructTextForRowWidget(DisplayName, AssetNameFont)
-		]
+	if(NumRemovedItems == 0) return 0;
 
-		//Fourth Slot
-		+SHorizontalBox::Slot()
-		.HAlign(HAlign_Right)
-		.VAlign(VAlign_Fill)
-		[
-			ConstructButtonForRowWidget(AssetDataToDisplay)
-		]
-		
-	];
+	auto IsItemRemoved = [&RemovedItems](const TSharedPtr<FAdvancedDeleteListItem>& Item)
+	{
+		return RemovedItems[Item->ItemIndex];
+	};
 
-	return ListViewRowWidget;
+	StoredAssetsData.RemoveAll(IsItemRemoved);
+	ListedAssetsData.RemoveAll(IsItemRemoved);
+	DisplayedAssetsData.RemoveAll(IsItemRemoved);
+
+	return NumRemovedItems;
 }
 
-void SAdvancedDeleteTab::OnRowWidgetMouseButtonClicked(TSharedPtr<FAssetData> ClickedData)
+void SAdvancedDeleteTab::RemoveDeletedItems(const TSet<FSoftObjectPath>& DeletedAssetPaths)
 {
-	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>("SuperManager");
+	if(RemoveStoredItems(DeletedAssetPaths) == 0) return;
 
-	SuperManagerModule.SyncSBToClickedAssetForAssetList(ClickedData->ObjectPath.ToString());
+	FilterPipeline.InvalidateInputs(EAdvancedDeleteFilterInputs::AllItems);
+
+	//Dropping an item can clear the verdict on items sharing a name with it
+	if(FilterPipeline.DoActiveFiltersRead(EAdvancedDeleteFilterInputs::AllItems))
+	{
+		ListAssetsForFilters(StoredAssetsData, ListedAssetsData);
+		SortListedAssetsData();
+		ApplySearchFilter();
+	}
+	else
+	{
+		RebuildAssetListRootItems();
+		RebuildFolderTree();
+	}
 }
 
-TSharedRef<SCheckBox> SAdvancedDeleteTab::ConstructCheckBox(const TSharedPtr<FAssetData> AssetDataToDisplay)
+#pragma region DuplicateGroups
+
+void SAdvancedDeleteTab::RebuildAssetListRootItems()
 {
-	TSharedRef<SCheckBox> ConstructedCheckbox = SNew(SCheckBox)
-	.Type(ESlateCheckBoxType::CheckBox)
-	.OnCheckStateChanged(this, &SAdvancedDeleteTab::OnCheckBoxStateChanged, AssetDataToDisplay)
-	.Visibility(EVisibility::Visible);
+	DuplicateGroupMembers.Reset();
 
-	CheckboxesArray.Add(ConstructedCheckbox);
-	return ConstructedCheckbox;
-}
+	const bool bGroupByContent = FilterPipeline.IsFilterActive(AdvancedDeleteFilterIds::SameContent);
+	const bool bGroupByGeometry = FilterPipeline.IsFilterActive(AdvancedDeleteFilterIds::SameGeometry);
+	const bool bGroupByLooks = FilterPipeline.IsFilterActive(AdvancedDeleteFilterIds::SimilarTextures);
 
-void SAdvancedDeleteTab::OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData)
-{
-	switch (NewState) {
-	case ECheckBoxState::Unchecked:
+	if(!bGroupByContent && !bGroupByGeometry && !bGroupByLooks && !FilterPipeline.IsFilterActive(AdvancedDeleteFilterIds::SameName))
+	{
+		AssetListRootItems = DisplayedAssetsData;
+		return;
+	}
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	//The strongest match of the active filters decides, identical contents before identical geometry before similar looks before shared names
+	TArray<TArray<TSharedPtr<FAdvancedDeleteListItem>>> DuplicateGroups;
+
+	if(bGroupByContent)
+	{
+		SuperManagerModule.GroupSameContentAssetsForAssetList(DisplayedAssetsData, DuplicateGroups);
+	}
+	else if(bGroupByGeometry)
+	{
+		SuperManagerModule.GroupSameGeometryAssetsForAssetList(DisplayedAssetsData, DuplicateGroups);
+	}
+	else if(bGroupByLooks)
+	{
+		SuperManagerModule.GroupSimilarTexturesForAssetList(DisplayedAssetsData, DuplicateGroups);
+	}
+	else
+	{
+		SuperManagerModule.GroupSameNameAssetsForAssetList(DisplayedAssetsData, DuplicateGroups);
+	}
+
+	AssetListRootItems.Reset(DuplicateGroups.Num());
+
+	//The first displayed item of a group stands for it, so the groups follow the sort order
+	for(TArray<TSharedPtr<FAdvancedDeleteListItem>>& DuplicateGroup : DuplicateGroups)
+	{
+		const TSharedPtr<FAdvancedDeleteListItem> RootItem = DuplicateGroup[0];
+		AssetListRootItems.Add(RootItem);
 
-		if(AssetsDataToDeleteArray.Contains(AssetData))
+		if(DuplicateGroup.Num() > 1)
 		{
-			AssetsDataToDeleteArray.Remove(AssetData);
+			DuplicateGroup.RemoveAt(0, 1, EAllowShrinking::No);
+			DuplicateGroupMembers.Add(RootItem->ItemIndex, MoveTemp(DuplicateGroup));
 		}
-		
-		break;
-		
-	case ECheckBoxState::Checked:
+	}
+}
 
-		AssetsDataToDeleteArray.AddUnique(AssetData);
-		
-		break;
-		
-	case ECheckBoxState::Undetermined:
-		break;
+void SAdvancedDeleteTab::OnGetAssetListChildren(TSharedPtr<FAdvancedDeleteListItem> Item,
+	TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutChildItems)
+{
+	if(const TArray<TSharedPtr<FAdvancedDeleteListItem>>* GroupMembers = DuplicateGroupMembers.Find(Item->ItemIndex))
+	{
+		OutChildItems = *GroupMembers;
 	}
 }
 
-TSharedRef<STextBlock> SAdvancedDeleteTab::ConstructTextForRowWidget(const FString& TextContent,
-	const FSlateFontInfo& FontToUse)
+int32 SAdvancedDeleteTab::GetDuplicateGroupSize(const TSharedPtr<FAdvancedDeleteListItem>& Item) const
 {
-	TSharedRef<STextBlock> ConstructedTextBlock = SNew(STextBlock)
-	.Text(FText::FromString(TextContent))
-	.Font(FontToUse)
-	.ColorAndOpacity(FColor::White);
+	const TArray<TSharedPtr<FAdvancedDeleteListItem>>* GroupMembers = DuplicateGroupMembers.Find(Item->ItemIndex);
 
-	return ConstructedTextBlock;
+	return GroupMembers ? GroupMembers->Num() + 1 : 0;
 }
 
-TSharedRef<SButton> SAdvancedDeleteTab::ConstructButtonForRowWidget(const TSharedPtr<FAssetData> AssetDataToDisplay)
-{
-	TSharedRef<SButton> ConstructedButton = SNew(SButton)
-	.Text(FText::FromString(TEXT("Delete")))
-	.OnClicked(this, &SAdvancedDeleteTab::OnDeleteButtonClicked, AssetDataToDisplay);
+#pragma endregion
 
-	return ConstructedButton;
+#pragma region AssetListSorting
+
+TSharedRef<SHeaderRow> SAdvancedDeleteTab::ConstructHeaderRow()
+{
+	ConstructedHeaderRow = SNew(SHeaderRow)
+
+	+SHeaderRow::Column(AdvancedDeleteColumns::CheckBox)
+	.DefaultLabel(FText::GetEmpty())
+	.FixedWidth(30.f)
+
+	//Hidden until thumbnails are turned on, rows only generate cells for shown columns
+	+SHeaderRow::Column(AdvancedDeleteColumns::Thumbnail)
+	.DefaultLabel(FText::GetEmpty())
+	.FixedWidth(ThumbnailRowResolution + 8.f)
+	.ShouldGenerateWidget(false)
+
+	+SHeaderRow::Column(AdvancedDeleteColumns::Name)
+	.DefaultLabel(FText::FromString(TEXT("Name")))
+	.FillWidth(.25f)
+	.SortMode(this, &SAdvancedDeleteTab::GetColumnSortMode, AdvancedDeleteColumns::Name)
+	.OnSort(this, &SAdvancedDeleteTab::OnColumnSortModeChanged)
+
+	+SHeaderRow::Column(AdvancedDeleteColumns::Class)
+	.DefaultLabel(FText::FromString(TEXT("Class")))
+	.FillWidth(.12f)
+	.SortMode(this, &SAdvancedDeleteTab::GetColumnSortMode, AdvancedDeleteColumns::Class)
+	.OnSort(this, &SAdvancedDeleteTab::OnColumnSortModeChanged)
+
+	+SHeaderRow::Column(AdvancedDeleteColumns::Path)
+	.DefaultLabel(FText::FromString(TEXT("Path")))
+	.FillWidth(.3f)
+	.SortMode(this, &SAdvancedDeleteTab::GetColumnSortMode, AdvancedDeleteColumns::Path)
+	.OnSort(this, &SAdvancedDeleteTab::OnColumnSortModeChanged)
+
+	+SHeaderRow::Column(AdvancedDeleteColumns::DiskSize)
+	.DefaultLabel(FText::FromString(TEXT("Disk Size")))
+	.FillWidth(.08f)
+	.SortMode(this, &SAdvancedDeleteTab::GetColumnSortMode, AdvancedDeleteColumns::DiskSize)
+	.OnSort(this, &SAdvancedDeleteTab::OnColumnSortModeChanged)
+
+	+SHeaderRow::Column(AdvancedDeleteColumns::MemorySize)
+	.DefaultLabel(FText::FromString(TEXT("Memory Size")))
+	.FillWidth(.08f)
+	.SortMode(this, &SAdvancedDeleteTab::GetColumnSortMode, AdvancedDeleteColumns::MemorySize)
+	.OnSort(this, &SAdvancedDeleteTab::OnColumnSortModeChanged)
+
+	+SHeaderRow::Column(AdvancedDeleteColumns::Referencers)
+	.DefaultLabel(FText::FromString(TEXT("Referencers")))
+	.FillWidth(.08f)
+	.SortMode(this, &SAdvancedDeleteTab::GetColumnSortMode, AdvancedDeleteColumns::Referencers)
+	.OnSort(this, &SAdvancedDeleteTab::OnColumnSortModeChanged)
+
+	+SHeaderRow::Column(AdvancedDeleteColumns::LastModified)
+	.DefaultLabel(FText::FromString(TEXT("Last Modified")))
+	.FillWidth(.12f)
+	.SortMode(this, &SAdvancedDeleteTab::GetColumnSortMode, AdvancedDeleteColumns::LastModified)
+	.OnSort(this, &SAdvancedDeleteTab::OnColumnSortModeChanged)
+
+	+SHeaderRow::Column(AdvancedDeleteColumns::Delete)
+	.DefaultLabel(FText::GetEmpty())
+	.FixedWidth(70.f);
+
+	return ConstructedHeaderRow.ToSharedRef();
 }
 
-FReply SAdvancedDeleteTab::OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAssetData)
+EColumnSortMode::Type SAdvancedDeleteTab::GetColumnSortMode(FName ColumnId) const
 {
-	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>("SuperManager");
-	
-	const bool bAssetDeleted = SuperManagerModule.DeleteSingleAssetForAssetList(*ClickedAssetData.Get());
+	return ColumnId == SortColumnId ? SortMode : EColumnSortMode::None;
+}
 
-	if(bAssetDeleted)
-	{
-		if(StoredAssetsData.Contains(ClickedAssetData))
-		{
-			StoredAssetsData.Remove(ClickedAssetData);
-		}
+void SAdvancedDeleteTab::OnColumnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId,
+	EColumnSortMode::Type NewSortMode)
+{
+	//Items still being sized sort as unknown for now, the list is sorted again once every size is known
+	SortColumnId = ColumnId;
+	SortMode = NewSortMode;
 
-		if(DisplayedAssetsData.Contains(ClickedAssetData))
-		{
-			DisplayedAssetsData.Remove(ClickedAssetData);
-		}
+	SortListedAssetsData();
+	ApplySearchFilter();
 
-		RefreshAssetListView();
+	if(ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
 	}
-	
-	return FReply::Handled();
 }
 
+struct FListItemSortEntry
+{
+	int64 SortKey = 0;
+	int32 ItemPosition = INDEX_NONE;
+};
+
+//Replaces every distinct name by its lexical rank, so sorting compares integers instead of strings
+template<typename GetNameFuncType>
+static void BuildNameSortKeys(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items, GetNameFuncType GetName,
+	TArray<FListItemSortEntry>& SortEntries)
+{
+	TMap<FName, int32> NameRanks;
 
+	for(const TSharedPtr<FAdvancedDeleteListItem>& Item : Items)
+	{
+		NameRanks.Add(GetName(*Item), 0);
+	}
 
-#pragma endregion
+	TArray<FName> DistinctNames;
+	NameRanks.GenerateKeyArray(DistinctNames);
+	DistinctNames.Sort(FNameLexicalLess());
 
-#pragma region TabButtons
+	for(int32 NameRank = 0; NameRank < DistinctNames.Num(); ++NameRank)
+	{
+		NameRanks.FindChecked(DistinctNames[NameRank]) = NameRank;
+	}
 
-TSharedRef<SButton> SAdvancedDeleteTab::ConstructDeleteAllButton()
+	ParallelFor(Items.Num(), [&](int32 ItemPosition)
+	{
+		SortEntries[ItemPosition].SortKey = NameRanks.FindChecked(GetName(*Items[ItemPosition]));
+	});
+}
+
+//Sorts chunks on worker threads, then merges pairs of sorted runs in parallel until one run is left
+static void ParallelSortEntries(TArray<FListItemSortEntry>& SortEntries, bool bDescending)
 {
-	TSharedRef<SButton> DeleteAllButton = SNew(SButton)
-	.ContentPadding(FMargin(5.f))
-	.OnClicked(this, &SAdvancedDeleteTab::OnDeleteAllButtonClicked);
+	//The position tie break makes the order total, so the result does not depend on how the entries were chunked
+	auto IsSortedBefore = [bDescending](const FListItemSortEntry& A, const FListItemSortEntry& B)
+	{
+		if(A.SortKey != B.SortKey) return bDescending ? A.SortKey > B.SortKey : A.SortKey < B.SortKey;
 
-	DeleteAllButton->SetContent(ConstructTextForTabButtons(TEXT("Delete All")));
+		return A.ItemPosition < B.ItemPosition;
+	};
 
-	return DeleteAllButton;
-}
+	const int32 NumEntries = SortEntries.Num();
+	const int32 MinEntriesPerChunk = 16384;
+	const int32 NumChunks = FMath::Clamp(NumEntries / MinEntriesPerChunk, 1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
 
-FReply SAdvancedDeleteTab::OnDeleteAllButtonClicked()
-{
-	if(AssetsDataToDeleteArray.Num() == 0)
+	if(NumChunks == 1)
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No assets curently selected"));
-		return FReply::Handled();
+		Algo::Sort(SortEntries, IsSortedBefore);
+		return;
 	}
 
-	TArray<FAssetData> AssetDataToDelete;
+	const int32 EntriesPerChunk = FMath::DivideAndRoundUp(NumEntries, NumChunks);
 
-	for(const TSharedPtr<FAssetData>& Data : AssetsDataToDeleteArray)
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
 	{
-		AssetDataToDelete.Add(*Data.Get());
-	}
+		const int32 ChunkStart = ChunkIndex * EntriesPerChunk;
+		const int32 ChunkEnd = FMath::Min(ChunkStart + EntriesPerChunk, NumEntries);
 
-	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>("SuperManager");
+		Algo::Sort(TArrayView<FListItemSortEntry>(SortEntries.GetData() + ChunkStart, ChunkEnd - ChunkStart), IsSortedBefore);
+	});
 
-	const bool bAssetDataDeleted = SuperManagerModule.DeleteMultipleAssetsForAssetsList(AssetDataToDelete);
+	TArray<FListItemSortEntry> MergedEntries;
+	MergedEntries.SetNumUninitialized(NumEntries);
 
-	if(bAssetDataDeleted)
+	for(int32 RunLength = EntriesPerChunk; RunLength < NumEntries; RunLength *= 2)
 	{
-		for(const TSharedPtr<FAssetData>& DeletedData : AssetsDataToDeleteArray)
+		const int32 NumMerges = FMath::DivideAndRoundUp(NumEntries, RunLength * 2);
+
+		ParallelFor(NumMerges, [&](int32 MergeIndex)
 		{
-			if(StoredAssetsData.Contains(DeletedData))
-			{
-				StoredAssetsData.Remove(DeletedData);
-			}
-			if(DisplayedAssetsData.Contains(DeletedData))
+			const int32 MergeStart = MergeIndex * RunLength * 2;
+			const int32 MergeMiddle = FMath::Min(MergeStart + RunLength, NumEntries);
+			const int32 MergeEnd = FMath::Min(MergeStart + RunLength * 2, NumEntries);
+
+			int32 LeftIndex = MergeStart;
+			int32 RightIndex = MergeMiddle;
+
+			for(int32 OutIndex = MergeStart; OutIndex < MergeEnd; ++OutIndex)
 			{
-				DisplayedAssetsData.Remove(DeletedData);
+				const bool bTakeLeft = RightIndex >= MergeEnd ||
+					(LeftIndex < MergeMiddle && IsSortedBefore(SortEntries[LeftIndex], SortEntries[RightIndex]));
+
+				MergedEntries[OutIndex] = bTakeLeft ? SortEntries[LeftIndex++] : SortEntries[RightIndex++];
 			}
-		}
+		});
 
-		RefreshAssetListView();
+		Swap(SortEntries, MergedEntries);
 	}
-	
-	return FReply::Handled();
 }
 
-TSharedRef<SButton> SAdvancedDeleteTab::ConstructSelectAllButton()
+static int64 GetNumericSortKey(const FAdvancedDeleteListItem& Item, FName ColumnId)
 {
-	TSharedRef<SButton> SelectAllButton = SNew(SButton)
-	.ContentPadding(FMargin(5.f))
-	.OnClicked(this, &SAdvancedDeleteTab::OnSelectAllButtonClicked);
-
-	SelectAllButton->SetContent(ConstructTextForTabButtons(TEXT("Select All")));
+	if(ColumnId == AdvancedDeleteColumns::DiskSize) return Item.DiskSize;
+	if(ColumnId == AdvancedDeleteColumns::MemorySize) return Item.MemorySize;
+	if(ColumnId == AdvancedDeleteColumns::Referencers) return Item.ReferencerCount;
+	if(ColumnId == AdvancedDeleteColumns::LastModified) return Item.LastModified.GetTicks();
 
-	return SelectAllButton;
+	return 0;
 }
 
-FReply SAdvancedDeleteTab::OnSelectAllButtonClicked()
+//Negative when A comes first in ascending order, the same order the sort keys above give
+static int32 CompareItemsForColumn(const FAdvancedDeleteListItem& A, const FAdvancedDeleteListItem& B, FName ColumnId)
 {
-	if(CheckboxesArray.Num() == 0) return FReply::Handled();
+	if(ColumnId == AdvancedDeleteColumns::Name) return A.AssetData.AssetName.Compare(B.AssetData.AssetName);
+	if(ColumnId == AdvancedDeleteColumns::Class) return A.AssetData.AssetClassPath.GetAssetName().Compare(B.AssetData.AssetClassPath.GetAssetName());
+	if(ColumnId == AdvancedDeleteColumns::Path) return A.AssetData.PackagePath.Compare(B.AssetData.PackagePath);
 
-	for(const TSharedRef<SCheckBox> CheckBox : CheckboxesArray)
-	{
-		if(!CheckBox->IsChecked())
-		{
-			CheckBox->ToggleCheckedState();
-		}
-	}
-	return FReply::Handled();
+	const int64 KeyA = GetNumericSortKey(A, ColumnId);
+	const int64 KeyB = GetNumericSortKey(B, ColumnId);
+
+	return KeyA < KeyB ? -1 : (KeyA > KeyB ? 1 : 0);
 }
 
-TSharedRef<SButton> SAdvancedDeleteTab::ConstructDeselectAllButton()
+bool SAdvancedDeleteTab::IsListSorted() const
 {
-	TSharedRef<SButton> DeselectAllButton = SNew(SButton)
-	.ContentPadding(FMargin(5.f))
-	.OnClicked(this, &SAdvancedDeleteTab::OnDeselectAllButtonClicked);
-
-	DeselectAllButton->SetContent(ConstructTextForTabButtons(TEXT("Deselect All")));
+	return !SortColumnId.IsNone() && SortMode != EColumnSortMode::None;
+}
 
-	return DeselectAllButton;
+void SAdvancedDeleteTab::SortListedAssetsData()
+{
+	SortAssetItems(ListedAssetsData);
 }
 
-FReply SAdvancedDeleteTab::OnDeselectAllButtonClicked()
+void SAdvancedDeleteTab::SortAssetItems(TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items) const
 {
-	if(CheckboxesArray.Num() == 0) return FReply::Handled();
+	if(!IsListSorted() || Items.Num() < 2) return;
 
-	for(const TSharedRef<SCheckBox> CheckBox : CheckboxesArray)
+	TArray<FListItemSortEntry> SortEntries;
+	SortEntries.SetNum(Items.Num());
+
+	for(int32 ItemPosition = 0; ItemPosition < SortEntries.Num(); ++ItemPosition)
 	{
-		if(CheckBox->IsChecked())
-		{
-			CheckBox->ToggleCheckedState();
+		SortEntries[ItemPosition].ItemPosition = ItemPosition;
+	}
+
+	if(SortColumnId == AdvancedDeleteColumns::Name)
+	{
+		BuildNameSortKeys(Items, [](const FAdvancedDeleteListItem& Item)
+		{
+			return Item.AssetData.AssetName;
+		}, SortEntries);
+	}
+	else if(SortColumnId == AdvancedDeleteColumns::Class)
+	{
+		BuildNameSortKeys(Items, [](const FAdvancedDeleteListItem& Item)
+		{
+			return Item.AssetData.AssetClassPath.GetAssetName();
+		}, SortEntries);
+	}
+	else if(SortColumnId == AdvancedDeleteColumns::Path)
+	{
+		BuildNameSortKeys(Items, [](const FAdvancedDeleteListItem& Item)
+		{
+			return Item.AssetData.PackagePath;
+		}, SortEntries);
+	}
+	else
+	{
+		const FName NumericColumnId = SortColumnId;
+
+		ParallelFor(Items.Num(), [&](int32 ItemPosition)
+		{
+			SortEntries[ItemPosition].SortKey = GetNumericSortKey(*Items[ItemPosition], NumericColumnId);
+		});
+	}
+
+	ParallelSortEntries(SortEntries, SortMode == EColumnSortMode::Descending);
+
+	TArray<TSharedPtr<FAdvancedDeleteListItem>> SortedAssetsData;
+	SortedAssetsData.Reserve(SortEntries.Num());
+
+	for(const FListItemSortEntry& SortEntry : SortEntries)
+	{
+		SortedAssetsData.Add(MoveTemp(Items[SortEntry.ItemPosition]));
+	}
+
+	Items = MoveTemp(SortedAssetsData);
+}
+
+void SAdvancedDeleteTab::MergeIntoSortedItems(TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items,
+	TArray<TSharedPtr<FAdvancedDeleteListItem>>&& SortedNewItems) const
+{
+	if(SortedNewItems.Num() == 0) return;
+
+	if(!IsListSorted() || Items.Num() == 0)
+	{
+		Items.Append(MoveTemp(SortedNewItems));
+		return;
+	}
+
+	const bool bDescending = SortMode == EColumnSortMode::Descending;
+
+	TArray<TSharedPtr<FAdvancedDeleteListItem>> MergedItems;
+	MergedItems.Reserve(Items.Num() + SortedNewItems.Num());
+
+	int32 ItemPosition = 0;
+	int32 NewPosition = 0;
+
+	//Items already in win ties, the order a full sort with its position tie break would give the appended items
+	while(ItemPosition < Items.Num() || NewPosition < SortedNewItems.Num())
+	{
+		bool bTakeNew = ItemPosition >= Items.Num();
+
+		if(!bTakeNew && NewPosition < SortedNewItems.Num())
+		{
+			const int32 Comparison = CompareItemsForColumn(*SortedNewItems[NewPosition], *Items[ItemPosition], SortColumnId);
+			bTakeNew = bDescending ? Comparison > 0 : Comparison < 0;
+		}
+
+		MergedItems.Add(bTakeNew ? MoveTemp(SortedNewItems[NewPosition++]) : MoveTemp(Items[ItemPosition++]));
+	}
+
+	Items = MoveTemp(MergedItems);
+}
+
+#pragma endregion
+
+#pragma region StreamingGatheredAssets
+
+EActiveTimerReturnType SAdvancedDeleteTab::OnStreamGatheredAssets(double InCurrentTime, float InDeltaTime)
+{
+	//Read before consuming, so nothing gathered after the check can be left behind
+	const bool bGatheringComplete = AssetDataGatherer->IsComplete();
+
+	TArray<FGatheredAssetData> NewAssetsData;
+	const int32 NumConsumedAssets = AssetDataGatherer->ConsumeGatheredAssetsData(NewAssetsData, MaxStreamedAssetsPerRefresh);
+
+	if(NumConsumedAssets > 0)
+	{
+		FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+		const FAssetReferenceGraph& ReferenceGraph = SuperManagerModule.GetAssetReferenceGraph();
+
+		TArray<TSharedPtr<FAdvancedDeleteListItem>> NewItems;
+		NewItems.Reserve(NumConsumedAssets);
+
+		StoredAssetsData.Reserve(StoredAssetsData.Num() + NumConsumedAssets);
+
+		for(FGatheredAssetData& NewAssetData : NewAssetsData)
+		{
+			if(TSharedPtr<FAdvancedDeleteListItem> NewItem = AddStoredItem(MoveTemp(NewAssetData), ReferenceGraph))
+			{
+				NewItems.Add(MoveTemp(NewItem));
+			}
+		}
+
+		EnqueueSizeCalculation(NewItems);
+
+		if(ContentHasher.IsValid())
+		{
+			EnqueueContentHashing(NewItems);
+		}
+
+		if(TexturePerceptualHasher.IsValid())
+		{
+			EnqueueTextureHashing(NewItems);
+		}
+
+		if(GeometryHasher.IsValid())
+		{
+			EnqueueGeometryHashing(NewItems);
+		}
+
+		AppendToListedAssetsData(NewItems);
+		ApplySearchFilter();
+
+		//Adds rows for the new items only, existing rows and their check state are kept
+		if(ConstructedAssetListView.IsValid())
+		{
+			ConstructedAssetListView->RequestListRefresh();
+		}
+	}
+
+	if(bGatheringComplete && NumConsumedAssets < MaxStreamedAssetsPerRefresh)
+	{
+		AssetDataGatherer.Reset();
+		return EActiveTimerReturnType::Stop;
+	}
+
+	return EActiveTimerReturnType::Continue;
+}
+
+void SAdvancedDeleteTab::AppendToListedAssetsData(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& NewItems)
+{
+	FilterPipeline.InvalidateInputs(EAdvancedDeleteFilterInputs::AllItems);
+
+	//Filters reading other items can change their verdict on items already listed, the others only need the new items
+	if(FilterPipeline.DoActiveFiltersRead(EAdvancedDeleteFilterInputs::AllItems))
+	{
+		ListAssetsForFilters(StoredAssetsData, ListedAssetsData);
+		SortListedAssetsData();
+		return;
+	}
+
+	TArray<TSharedPtr<FAdvancedDeleteListItem>> NewListedAssetsData;
+	ListAssetsForFilters(NewItems, NewListedAssetsData);
+
+	//Only the batch is sorted, the listed items already are and it is merged into them
+	SortAssetItems(NewListedAssetsData);
+	MergeIntoSortedItems(ListedAssetsData, MoveTemp(NewListedAssetsData));
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+void SAdvancedDeleteTab::AddItemsForTesting(TArray<FGatheredAssetData>&& GatheredAssetsData)
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const FAssetReferenceGraph& ReferenceGraph = SuperManagerModule.GetAssetReferenceGraph();
+
+	TArray<TSharedPtr<FAdvancedDeleteListItem>> NewItems;
+	NewItems.Reserve(GatheredAssetsData.Num());
+
+	//Stored and listed like a streamed batch, without sizing or hashing packages that may not exist
+	for(FGatheredAssetData& GatheredAssetData : GatheredAssetsData)
+	{
+		if(TSharedPtr<FAdvancedDeleteListItem> NewItem = AddStoredItem(MoveTemp(GatheredAssetData), ReferenceGraph))
+		{
+			NewItems.Add(MoveTemp(NewItem));
+		}
+	}
+
+	AppendToListedAssetsData(NewItems);
+	ApplySearchFilter();
+
+	if(ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+}
+#endif
+
+TSharedRef<SWidget> SAdvancedDeleteTab::ConstructGatheringProgressWidget()
+{
+	return SNew(SHorizontalBox)
+	.Visibility_Lambda([this]()
+	{
+		const bool bHashesPending = AreContentHashesPending() || AreTextureHashesPending() || AreGeometryHashesPending();
+		return IsGatheringAssets() || bHashesPending ? EVisibility::Visible : EVisibility::Collapsed;
+	})
+
+	+SHorizontalBox::Slot()
+	.AutoWidth()
+	.Padding(5.f)
+	[
+		SNew(SCircularThrobber)
+		.Radius(8.f)
+	]
+
+	+SHorizontalBox::Slot()
+	.VAlign(VAlign_Center)
+	.Padding(5.f)
+	[
+		SNew(STextBlock)
+		.Text_Lambda([this]()
+		{
+			if(!IsGatheringAssets()) return FText::FromString(TEXT("Hashing assets..."));
+
+			const int32 NumGatheredAssets = AssetDataGatherer->GetNumGatheredAssets();
+			return FText::FromString(TEXT("Gathering assets... ") + FString::FromInt(NumGatheredAssets) + TEXT(" found so far"));
+		})
+	];
+}
+
+bool SAdvancedDeleteTab::IsGatheringAssets() const
+{
+	return AssetDataGatherer.IsValid();
+}
+
+#pragma endregion
+
+#pragma region AssetSizes
+
+void SAdvancedDeleteTab::StartPollingSizeResults()
+{
+	if(bIsPollingSizeResults) return;
+
+	bIsPollingSizeResults = true;
+
+	RegisterActiveTimer(SizePollInterval,
+		FWidgetActiveTimerDelegate::CreateSP(this, &SAdvancedDeleteTab::OnPollSizeResults));
+}
+
+void SAdvancedDeleteTab::EnqueueSizeCalculation(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items)
+{
+	TArray<FAssetSizeRequest> SizeRequests;
+	SizeRequests.Reserve(Items.Num());
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& Item : Items)
+	{
+		FAssetSizeRequest& SizeRequest = SizeRequests.AddDefaulted_GetRef();
+		SizeRequest.ItemIndex = Item->ItemIndex;
+		SizeRequest.AssetData = Item->AssetData;
+	}
+
+	SizeCalculator->Enqueue(MoveTemp(SizeRequests));
+}
+
+EActiveTimerReturnType SAdvancedDeleteTab::OnPollSizeResults(double InCurrentTime, float InDeltaTime)
+{
+	//Read before consuming, so no result finished after the check can be left behind
+	const bool bSizesComplete = !AssetDataGatherer.IsValid() && SizeCalculator->IsIdle();
+
+	TArray<FAssetSizeResult> SizeResults;
+	SizeCalculator->ConsumeSizeResults(SizeResults);
+
+	if(SizeResults.Num() > 0)
+	{
+		//Results are keyed by item index, items deleted meanwhile are simply not found
+		for(const FAssetSizeResult& SizeResult : SizeResults)
+		{
+			FAdvancedDeleteListItem* Item = FindStoredItem(SizeResult.ItemIndex);
+
+			if(!Item) continue;
+
+			//Only the folders above the item change, an item sized again first takes its old sizes back
+			if(Item->bSizesCalculated)
+			{
+				FolderSizeTree.AddItem(*Item, -1);
+			}
+
+			Item->DiskSize = SizeResult.DiskSize;
+			Item->MemorySize = SizeResult.MemorySize;
+			Item->bSizesCalculated = true;
+
+			FolderSizeTree.AddItem(*Item);
+		}
+
+		FilterPipeline.InvalidateInputs(EAdvancedDeleteFilterInputs::AssetSizes);
+
+		if(FilterPipeline.DoActiveFiltersRead(EAdvancedDeleteFilterInputs::AssetSizes))
+		{
+			ListAssetsForFilters(StoredAssetsData, ListedAssetsData);
+			SortListedAssetsData();
+			ApplySearchFilter();
+
+			if(ConstructedAssetListView.IsValid())
+			{
+				ConstructedAssetListView->RequestListRefresh();
+			}
+		}
+		else
+		{
+			RebuildFolderTree();
+		}
+	}
+
+	if(!bSizesComplete) return EActiveTimerReturnType::Continue;
+
+	bIsPollingSizeResults = false;
+
+	//A size order requested while sizes were pending is completed now that every size is known
+	if(IsSortedBySize())
+	{
+		SortListedAssetsData();
+		ApplySearchFilter();
+
+		if(ConstructedAssetListView.IsValid())
+		{
+			ConstructedAssetListView->RequestListRefresh();
+		}
+	}
+
+	return EActiveTimerReturnType::Stop;
+}
+
+bool SAdvancedDeleteTab::IsSortedBySize() const
+{
+	return IsListSorted() && (SortColumnId == AdvancedDeleteColumns::DiskSize || SortColumnId == AdvancedDeleteColumns::MemorySize);
+}
+
+FText SAdvancedDeleteTab::GetFolderSizeTotalsText(FName FolderPath) const
+{
+	const int32 NodeIndex = FolderSizeTree.FindNodeIndex(FolderPath);
+
+	//A folder left without sized assets reads as not calculated again
+	if(NodeIndex == INDEX_NONE || FolderSizeTree.GetNode(NodeIndex).NumAssets <= 0)
+	{
+		return FText::FromString(TEXT("Folder sizes are still being calculated"));
+	}
+
+	const FAdvancedDeleteFolderNode& Totals = FolderSizeTree.GetNode(NodeIndex);
+
+	return FText::FromString(FString::Printf(TEXT("Folder total: %s on disk, %s in memory across %d assets"),
+		*FText::AsMemory(Totals.DiskSize).ToString(), *FText::AsMemory(Totals.MemorySize).ToString(), Totals.NumAssets));
+}
+
+#pragma endregion
+
+#pragma region ContentHashes
+
+void SAdvancedDeleteTab::StartContentHashingIfNeeded()
+{
+	if(ContentHasher.IsValid() || !FilterPipeline.DoActiveFiltersRead(EAdvancedDeleteFilterInputs::ContentHashes)) return;
+
+	ContentHasher = MakeShared<FAsyncAssetContentHasher, ESPMode::ThreadSafe>();
+
+	//Items streamed in later are hashed as they arrive
+	EnqueueContentHashing(StoredAssetsData);
+}
+
+void SAdvancedDeleteTab::EnqueueContentHashing(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items)
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const FAssetContentHashCache& ContentHashCache = SuperManagerModule.GetAssetContentHashCache();
+
+	TArray<FAssetContentHashRequest> HashRequests;
+	bool bCachedHashesApplied = false;
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& Item : Items)
+	{
+		if(const FAssetContentHash* CachedContentHash = ContentHashCache.FindContentHash(Item->AssetData.PackageName, Item->LastModified))
+		{
+			Item->ContentHash = *CachedContentHash;
+			bCachedHashesApplied = true;
+			continue;
+		}
+
+		FAssetContentHashRequest& HashRequest = HashRequests.AddDefaulted_GetRef();
+		HashRequest.ItemIndex = Item->ItemIndex;
+		HashRequest.PackageName = Item->AssetData.PackageName;
+		HashRequest.PackageTimeStamp = Item->LastModified;
+	}
+
+	//Callers list the items again after enqueuing, the cached hashes are picked up then
+	if(bCachedHashesApplied)
+	{
+		FilterPipeline.InvalidateInputs(EAdvancedDeleteFilterInputs::ContentHashes);
+	}
+
+	if(HashRequests.Num() == 0) return;
+
+	ContentHasher->Enqueue(MoveTemp(HashRequests));
+
+	if(bIsPollingContentHashResults) return;
+
+	bIsPollingContentHashResults = true;
+
+	RegisterActiveTimer(ContentHashPollInterval,
+		FWidgetActiveTimerDelegate::CreateSP(this, &SAdvancedDeleteTab::OnPollContentHashResults));
+}
+
+EActiveTimerReturnType SAdvancedDeleteTab::OnPollContentHashResults(double InCurrentTime, float InDeltaTime)
+{
+	//Read before consuming, so no result finished after the check can be left behind
+	const bool bHashesComplete = ContentHasher->IsIdle();
+
+	TArray<FAssetContentHashResult> HashResults;
+	ContentHasher->ConsumeHashResults(HashResults);
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	if(HashResults.Num() > 0)
+	{
+		FAssetContentHashCache& ContentHashCache = SuperManagerModule.GetAssetContentHashCache();
+
+		//Results are keyed by item index, items deleted meanwhile are simply not found
+		for(const FAssetContentHashResult& HashResult : HashResults)
+		{
+			ContentHashCache.AddContentHash(HashResult.PackageName, HashResult.PackageTimeStamp, HashResult.ContentHash);
+
+			//An item updated after the request was made is waiting for a newer hash
+			FAdvancedDeleteListItem* Item = FindStoredItem(HashResult.ItemIndex);
+
+			if(Item && Item->LastModified == HashResult.PackageTimeStamp)
+			{
+				Item->ContentHash = HashResult.ContentHash;
+			}
+		}
+
+		RelistForChangedInputs(EAdvancedDeleteFilterInputs::ContentHashes);
+	}
+
+	if(!bHashesComplete) return EActiveTimerReturnType::Continue;
+
+	bIsPollingContentHashResults = false;
+
+	SuperManagerModule.SaveAssetContentHashCache();
+
+	return EActiveTimerReturnType::Stop;
+}
+
+#pragma endregion
+
+#pragma region PerceptualHashes
+
+//Saved hash the registry knows for the asset's package, zero while the loaded asset has unsaved edits the hash would not cover
+static FIoHash GetPackageSavedHashForCaching(const FAssetData& AssetData)
+{
+	const UObject* LoadedAsset = AssetData.FastGetAsset(false);
+
+	if(LoadedAsset && LoadedAsset->GetPackage()->IsDirty()) return FIoHash::Zero;
+
+	const TOptional<FAssetPackageData> PackageData = IAssetRegistry::GetChecked().GetAssetPackageDataCopy(AssetData.PackageName);
+
+	return PackageData.IsSet() ? PackageData->GetPackageSavedHash() : FIoHash::Zero;
+}
+
+void SAdvancedDeleteTab::StartTextureHashingIfNeeded()
+{
+	if(TexturePerceptualHasher.IsValid() || !FilterPipeline.DoActiveFiltersRead(EAdvancedDeleteFilterInputs::PerceptualHashes)) return;
+
+	TexturePerceptualHasher = MakeShared<FAsyncTexturePerceptualHasher, ESPMode::ThreadSafe>();
+	TextureSourceLoader = MakeShared<FAsyncAssetSourceLoader>();
+
+	//Items streamed in later are hashed as they arrive
+	EnqueueTextureHashing(StoredAssetsData);
+}
+
+void SAdvancedDeleteTab::EnqueueTextureHashing(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items)
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const FAssetSourceHashCache& PerceptualHashCache = SuperManagerModule.GetPerceptualHashCache();
+
+	bool bTexturesEnqueued = false;
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& Item : Items)
+	{
+		if(!Item->AssetData.IsInstanceOf(UTexture2D::StaticClass())) continue;
+
+		bTexturesEnqueued = true;
+
+		const FIoHash PackageSavedHash = GetPackageSavedHashForCaching(Item->AssetData);
+
+		if(const uint64* CachedPerceptualHash = PerceptualHashCache.FindSourceHash(Item->AssetData.PackageName, PackageSavedHash))
+		{
+			Item->PerceptualHash = *CachedPerceptualHash;
+			Item->bPerceptualHashed = true;
+			continue;
+		}
+
+		TextureSourceLoader->Enqueue(Item->ItemIndex, Item->AssetData, PackageSavedHash);
+	}
+
+	//Cached hashes are clustered by the timer as well, once the textures still loading are hashed
+	if(bIsHashingTextures || !bTexturesEnqueued) return;
+
+	bIsHashingTextures = true;
+
+	RegisterActiveTimer(TextureHashInterval,
+		FWidgetActiveTimerDelegate::CreateSP(this, &SAdvancedDeleteTab::OnHashTextures));
+}
+
+EActiveTimerReturnType SAdvancedDeleteTab::OnHashTextures(double InCurrentTime, float InDeltaTime)
+{
+	//Reading the source has to stay on the game thread, it is cut off once the tick's budget is spent
+	const double ReadEndTime = FPlatformTime::Seconds() + TextureHashTimeBudget;
+
+	TArray<FLoadedAssetSource> LoadedTextures;
+
+	while(TexturePerceptualHasher->GetNumPendingImageBytes() < TextureHashMaxPendingBytes
+		&& FPlatformTime::Seconds() < ReadEndTime
+		&& TextureSourceLoader->ConsumeLoadedAssets(LoadedTextures, 1) > 0)
+	{
+		//Items deleted while loading are skipped
+		if(FindStoredItem(LoadedTextures.Last().ItemIndex))
+		{
+			ReadTextureSourceForHashing(LoadedTextures.Last());
+		}
+
+		TextureSourceLoader->Release(LoadedTextures.Last());
+	}
+
+	TextureSourceLoader->CollectReleasedPackages(false);
+
+	//Read before consuming, so no result finished after the check can be left behind
+	const bool bHashesComplete = TextureSourceLoader->IsIdle() && TexturePerceptualHasher->IsIdle();
+
+	TArray<FTexturePerceptualHashResult> HashResults;
+	TexturePerceptualHasher->ConsumeHashResults(HashResults);
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	FAssetSourceHashCache& PerceptualHashCache = SuperManagerModule.GetPerceptualHashCache();
+
+	//Results are keyed by item index, items deleted meanwhile are simply not found
+	for(const FTexturePerceptualHashResult& HashResult : HashResults)
+	{
+		PerceptualHashCache.AddSourceHash(HashResult.PackageName, HashResult.PackageSavedHash, HashResult.PerceptualHash);
+
+		//An item updated after its texture was read is waiting for a newer hash
+		FAdvancedDeleteListItem* Item = FindStoredItem(HashResult.ItemIndex);
+
+		if(Item && GetPackageSavedHashForCaching(Item->AssetData) == HashResult.PackageSavedHash)
+		{
+			Item->PerceptualHash = HashResult.PerceptualHash;
+			Item->bPerceptualHashed = true;
+		}
+	}
+
+	if(!bHashesComplete) return EActiveTimerReturnType::Continue;
+
+	bIsHashingTextures = false;
+
+	TextureSourceLoader->CollectReleasedPackages(true);
+
+	SuperManagerModule.SavePerceptualHashCache();
+
+	SuperManagerModule.ClusterSimilarTexturesForAssetList(StoredAssetsData);
+
+	RelistForChangedInputs(EAdvancedDeleteFilterInputs::PerceptualHashes);
+
+	return EActiveTimerReturnType::Stop;
+}
+
+bool SAdvancedDeleteTab::ReadTextureSourceForHashing(const FLoadedAssetSource& LoadedTexture)
+{
+	UTexture2D* Texture = Cast<UTexture2D>(LoadedTexture.Asset.Get());
+
+	if(!Texture || !Texture->Source.IsValid()) return false;
+
+	const int32 MipIndex = FAsyncTexturePerceptualHasher::GetSourceMipToHash(
+		Texture->Source.GetSizeX(), Texture->Source.GetSizeY(), Texture->Source.GetNumMips());
+
+	FImage SourceImage;
+
+	if(!Texture->Source.GetMipImage(SourceImage, 0, 0, MipIndex)) return false;
+
+	UPackage* Package = Texture->GetPackage();
+
+	//A texture edited since it was requested is hashed as it is now, but not cached against the saved package
+	const FIoHash PackageSavedHash = Package->IsDirty() ? FIoHash::Zero : LoadedTexture.PackageSavedHash;
+
+	TexturePerceptualHasher->Enqueue(LoadedTexture.ItemIndex, Package->GetFName(), PackageSavedHash, MoveTemp(SourceImage));
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region GeometryHashes
+
+void SAdvancedDeleteTab::StartGeometryHashingIfNeeded()
+{
+	if(GeometryHasher.IsValid() || !FilterPipeline.DoActiveFiltersRead(EAdvancedDeleteFilterInputs::GeometryHashes)) return;
+
+	GeometryHasher = MakeShared<FAsyncStaticMeshGeometryHasher, ESPMode::ThreadSafe>();
+	GeometrySourceLoader = MakeShared<FAsyncAssetSourceLoader>();
+
+	//Items streamed in later are hashed as they arrive
+	EnqueueGeometryHashing(StoredAssetsData);
+}
+
+void SAdvancedDeleteTab::EnqueueGeometryHashing(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items)
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const FAssetSourceHashCache& GeometryHashCache = SuperManagerModule.GetGeometryHashCache();
+
+	bool bCachedHashesApplied = false;
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& Item : Items)
+	{
+		if(!Item->AssetData.IsInstanceOf(UStaticMesh::StaticClass())) continue;
+
+		const FIoHash PackageSavedHash = GetPackageSavedHashForCaching(Item->AssetData);
+
+		if(const uint64* CachedGeometryHash = GeometryHashCache.FindSourceHash(Item->AssetData.PackageName, PackageSavedHash))
+		{
+			Item->GeometryHash = *CachedGeometryHash;
+			Item->bGeometryHashed = true;
+			bCachedHashesApplied = true;
+			continue;
+		}
+
+		GeometrySourceLoader->Enqueue(Item->ItemIndex, Item->AssetData, PackageSavedHash);
+	}
+
+	//Callers list the items again after enqueuing, the cached hashes are picked up then
+	if(bCachedHashesApplied)
+	{
+		FilterPipeline.InvalidateInputs(EAdvancedDeleteFilterInputs::GeometryHashes);
+	}
+
+	if(bIsHashingGeometry || GeometrySourceLoader->IsIdle()) return;
+
+	bIsHashingGeometry = true;
+
+	RegisterActiveTimer(GeometryHashInterval,
+		FWidgetActiveTimerDelegate::CreateSP(this, &SAdvancedDeleteTab::OnHashGeometry));
+}
+
+EActiveTimerReturnType SAdvancedDeleteTab::OnHashGeometry(double InCurrentTime, float InDeltaTime)
+{
+	//Reading the source model has to stay on the game thread, it is cut off once the tick's budget is spent
+	const double ReadEndTime = FPlatformTime::Seconds() + GeometryHashTimeBudget;
+
+	TArray<FLoadedAssetSource> LoadedStaticMeshes;
+
+	while(GeometryHasher->GetNumPendingGeometryBytes() < GeometryHashMaxPendingBytes
+		&& FPlatformTime::Seconds() < ReadEndTime
+		&& GeometrySourceLoader->ConsumeLoadedAssets(LoadedStaticMeshes, 1) > 0)
+	{
+		//Items deleted while loading are skipped
+		if(FindStoredItem(LoadedStaticMeshes.Last().ItemIndex))
+		{
+			ReadStaticMeshForHashing(LoadedStaticMeshes.Last());
+		}
+
+		GeometrySourceLoader->Release(LoadedStaticMeshes.Last());
+	}
+
+	GeometrySourceLoader->CollectReleasedPackages(false);
+
+	//Read before consuming, so no result finished after the check can be left behind
+	const bool bHashesComplete = GeometrySourceLoader->IsIdle() && GeometryHasher->IsIdle();
+
+	TArray<FStaticMeshGeometryHashResult> HashResults;
+	GeometryHasher->ConsumeHashResults(HashResults);
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	if(HashResults.Num() > 0)
+	{
+		FAssetSourceHashCache& GeometryHashCache = SuperManagerModule.GetGeometryHashCache();
+
+		//Results are keyed by item index, items deleted meanwhile are simply not found
+		for(const FStaticMeshGeometryHashResult& HashResult : HashResults)
+		{
+			GeometryHashCache.AddSourceHash(HashResult.PackageName, HashResult.PackageSavedHash, HashResult.GeometryHash);
+
+			//An item updated after its mesh was read is waiting for a newer hash
+			FAdvancedDeleteListItem* Item = FindStoredItem(HashResult.ItemIndex);
+
+			if(Item && GetPackageSavedHashForCaching(Item->AssetData) == HashResult.PackageSavedHash)
+			{
+				Item->GeometryHash = HashResult.GeometryHash;
+				Item->bGeometryHashed = true;
+			}
+		}
+
+		RelistForChangedInputs(EAdvancedDeleteFilterInputs::GeometryHashes);
+	}
+
+	if(!bHashesComplete) return EActiveTimerReturnType::Continue;
+
+	bIsHashingGeometry = false;
+
+	GeometrySourceLoader->CollectReleasedPackages(true);
+
+	SuperManagerModule.SaveGeometryHashCache();
+
+	return EActiveTimerReturnType::Stop;
+}
+
+bool SAdvancedDeleteTab::ReadStaticMeshForHashing(const FLoadedAssetSource& LoadedStaticMesh)
+{
+	UStaticMesh* StaticMesh = Cast<UStaticMesh>(LoadedStaticMesh.Asset.Get());
+
+	if(!StaticMesh) return false;
+
+	FStaticMeshGeometry Geometry;
+
+	if(!Geometry.ReadFromStaticMesh(*StaticMesh)) return false;
+
+	UPackage* Package = StaticMesh->GetPackage();
+
+	//A mesh edited since it was requested is hashed as it is now, but not cached against the saved package
+	const FIoHash PackageSavedHash = Package->IsDirty() ? FIoHash::Zero : LoadedStaticMesh.PackageSavedHash;
+
+	GeometryHasher->Enqueue(LoadedStaticMesh.ItemIndex, Package->GetFName(), PackageSavedHash, MoveTemp(Geometry));
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region Thumbnails
+
+TSharedRef<SCheckBox> SAdvancedDeleteTab::ConstructThumbnailToggle()
+{
+	TSharedRef<SCheckBox> ConstructedToggle = SNew(SCheckBox)
+	.Style(FCoreStyle::Get(), "ToggleButtonCheckbox")
+	.IsChecked_Lambda([this]()
+	{
+		return bShowThumbnails ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+	})
+	.OnCheckStateChanged(this, &SAdvancedDeleteTab::OnThumbnailsToggled)
+	[
+		SNew(STextBlock)
+		.Text(FText::FromString(TEXT("Thumbnails")))
+		.Margin(FMargin(5.f, 2.f))
+	];
+
+	return ConstructedToggle;
+}
+
+void SAdvancedDeleteTab::OnThumbnailsToggled(ECheckBoxState NewState)
+{
+	bShowThumbnails = NewState == ECheckBoxState::Checked;
+
+	if(bShowThumbnails && !ThumbnailCache.IsValid())
+	{
+		ThumbnailCache = MakeShared<FAdvancedDeleteThumbnailCache>(ThumbnailRowResolution, ThumbnailRowMemoryBudget);
+	}
+
+	//Realized rows add or drop the cell themselves when the header columns change
+	ConstructedHeaderRow->SetShowGeneratedColumn(AdvancedDeleteColumns::Thumbnail, bShowThumbnails);
+}
+
+TSharedRef<SWidget> SAdvancedDeleteTab::ConstructThumbnailForRowWidget(const TSharedPtr<FAdvancedDeleteListItem>& AssetDataToDisplay)
+{
+	if(!ThumbnailCache.IsValid()) return SNullWidget::NullWidget;
+
+	TSharedRef<FAssetThumbnail> Thumbnail = ThumbnailCache->FindOrAddThumbnail(*AssetDataToDisplay);
+
+	FAssetThumbnailConfig ThumbnailConfig;
+	ThumbnailConfig.bAllowFadeIn = true;
+
+	return SNew(SBox)
+	.WidthOverride(ThumbnailRowResolution)
+	.HeightOverride(ThumbnailRowResolution)
+	[
+		Thumbnail->MakeThumbnailWidget(ThumbnailConfig)
+	];
+}
+
+#pragma endregion
+
+#pragma region LiveRegistryUpdates
+
+void SAdvancedDeleteTab::OnAssetAddedToRegistry(const FAssetData& AddedAssetData)
+{
+	PendingAddedAssets.Add(AddedAssetData.GetSoftObjectPath(), AddedAssetData);
+
+	ScheduleRegistryChanges();
+}
+
+void SAdvancedDeleteTab::OnAssetRemovedFromRegistry(const FAssetData& RemovedAssetData)
+{
+	const FSoftObjectPath RemovedAssetPath = RemovedAssetData.GetSoftObjectPath();
+
+	//Removals are applied before additions, so an asset added and removed again before applying must not come back
+	PendingAddedAssets.Remove(RemovedAssetPath);
+	PendingUpdatedAssets.Remove(RemovedAssetPath);
+	PendingRemovedAssetPaths.Add(RemovedAssetPath);
+
+	ScheduleRegistryChanges();
+}
+
+void SAdvancedDeleteTab::OnAssetRenamedInRegistry(const FAssetData& RenamedAssetData, const FString& OldObjectPath)
+{
+	const FSoftObjectPath OldAssetPath(OldObjectPath);
+
+	PendingAddedAssets.Remove(OldAssetPath);
+	PendingUpdatedAssets.Remove(OldAssetPath);
+	PendingRemovedAssetPaths.Add(OldAssetPath);
+
+	PendingAddedAssets.Add(RenamedAssetData.GetSoftObjectPath(), RenamedAssetData);
+
+	ScheduleRegistryChanges();
+}
+
+void SAdvancedDeleteTab::OnAssetUpdatedInRegistry(const FAssetData& UpdatedAssetData)
+{
+	PendingUpdatedAssets.Add(UpdatedAssetData.GetSoftObjectPath(), UpdatedAssetData);
+
+	ScheduleRegistryChanges();
+}
+
+void SAdvancedDeleteTab::ScheduleRegistryChanges()
+{
+	if(RegistryChangesTimerHandle.IsValid()) return;
+
+	RegistryChangesTimerHandle = RegisterActiveTimer(RegistryChangesApplyDelay,
+		FWidgetActiveTimerDelegate::CreateSP(this, &SAdvancedDeleteTab::OnApplyRegistryChanges));
+}
+
+EActiveTimerReturnType SAdvancedDeleteTab::OnApplyRegistryChanges(double InCurrentTime, float InDeltaTime)
+{
+	RegistryChangesTimerHandle.Reset();
+
+	//The module updates the reference graph on the same events, by now every change of this batch is in it
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const FAssetReferenceGraph& ReferenceGraph = SuperManagerModule.GetAssetReferenceGraph();
+
+	const bool bItemsRemoved = RemoveStoredItems(PendingRemovedAssetPaths) > 0;
+
+	TMap<FName, FDateTime> PackageTimeStamps;
+	TArray<TSharedPtr<FAdvancedDeleteListItem>> ChangedItems;
+
+	for(TPair<FSoftObjectPath, FAssetData>& PendingUpdatedAsset : PendingUpdatedAssets)
+	{
+		const TSharedPtr<FAdvancedDeleteListItem>* UpdatedItem = ItemsByAssetPath.Find(PendingUpdatedAsset.Key);
+
+		if(!UpdatedItem) continue;
+
+		FAdvancedDeleteListItem& Item = **UpdatedItem;
+
+		//Its folders go without its sizes until the item has been sized again
+		if(Item.bSizesCalculated)
+		{
+			FolderSizeTree.AddItem(Item, -1);
+		}
+
+		Item.AssetData = MoveTemp(PendingUpdatedAsset.Value);
+		Item.LastModified = FAsyncAssetDataGatherer::GetPackageTimeStamp(Item.AssetData.PackageName, PackageTimeStamps);
+		Item.bSizesCalculated = false;
+		Item.ContentHash = FAssetContentHash();
+		Item.bPerceptualHashed = false;
+		Item.SimilarTextureClusterId = INDEX_NONE;
+		Item.bGeometryHashed = false;
+
+		FilterPipeline.InvalidateItem(Item.ItemIndex);
+
+		if(ThumbnailCache.IsValid())
+		{
+			ThumbnailCache->RemoveThumbnail(Item.ItemIndex);
+		}
+
+		ChangedItems.Add(*UpdatedItem);
+	}
+
+	for(TPair<FSoftObjectPath, FAssetData>& PendingAddedAsset : PendingAddedAssets)
+	{
+		if(!IsAssetInScanFolders(PendingAddedAsset.Value)) continue;
+
+		FGatheredAssetData GatheredAssetData;
+		GatheredAssetData.PackageTimeStamp = FAsyncAssetDataGatherer::GetPackageTimeStamp(PendingAddedAsset.Value.PackageName, PackageTimeStamps);
+		GatheredAssetData.AssetData = MoveTemp(PendingAddedAsset.Value);
+
+		if(TSharedPtr<FAdvancedDeleteListItem> NewItem = AddStoredItem(MoveTemp(GatheredAssetData), ReferenceGraph))
+		{
+			ChangedItems.Add(MoveTemp(NewItem));
+		}
+	}
+
+	PendingAddedAssets.Reset();
+	PendingUpdatedAssets.Reset();
+	PendingRemovedAssetPaths.Reset();
+
+	if(ChangedItems.Num() > 0)
+	{
+		EnqueueSizeCalculation(ChangedItems);
+		StartPollingSizeResults();
+
+		if(ContentHasher.IsValid())
+		{
+			EnqueueContentHashing(ChangedItems);
+		}
+
+		if(TexturePerceptualHasher.IsValid())
+		{
+			EnqueueTextureHashing(ChangedItems);
+		}
+
+		if(GeometryHasher.IsValid())
+		{
+			EnqueueGeometryHashing(ChangedItems);
+		}
+	}
+
+	//Only the items of packages that gained or lost referencers are counted again, every other count still holds
+	TArray<FName> RecountedPackageNames;
+	SuperManagerModule.ConsumeReferencerCountChanges(RecountedPackageNames);
+
+	TBitArray<> ChangedItemsMask(false, NextItemIndex);
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& ChangedItem : ChangedItems)
+	{
+		ChangedItemsMask[ChangedItem->ItemIndex] = true;
+	}
+
+	const bool bItemsChanged = bItemsRemoved || ChangedItems.Num() > 0;
+
+	for(const FName RecountedPackageName : RecountedPackageNames)
+	{
+		const int32 PackageIndex = ReferenceGraph.FindPackageIndex(RecountedPackageName);
+		const int32 ReferencerCount = PackageIndex != INDEX_NONE ? ReferenceGraph.GetNumReferencers(PackageIndex, EPackageReferenceType::Package) : 0;
+
+		for(auto It = StoredItemsByPackageName.CreateConstKeyIterator(RecountedPackageName); It; ++It)
+		{
+			const TSharedPtr<FAdvancedDeleteListItem>& Item = It.Value();
+
+			if(Item->ReferencerCount == ReferencerCount) continue;
+
+			Item->ReferencerCount = ReferencerCount;
+			FilterPipeline.InvalidateItemInputs(Item->ItemIndex, EAdvancedDeleteFilterInputs::ReferenceGraph);
+
+			if(!ChangedItemsMask[Item->ItemIndex])
+			{
+				ChangedItemsMask[Item->ItemIndex] = true;
+				ChangedItems.Add(Item);
+			}
+		}
+	}
+
+	//Any edge of the batch can change what is reachable from the roots, wherever it is
+	FilterPipeline.InvalidateInputs(EAdvancedDeleteFilterInputs::ReferencePaths);
+
+	if(bItemsChanged)
+	{
+		FilterPipeline.InvalidateInputs(EAdvancedDeleteFilterInputs::AllItems);
+	}
+
+	//Filters reading other items or other packages' references can change their verdict on any item, the others only on the changed ones
+	if((bItemsChanged && FilterPipeline.DoActiveFiltersRead(EAdvancedDeleteFilterInputs::AllItems))
+		|| FilterPipeline.DoActiveFiltersRead(EAdvancedDeleteFilterInputs::ReferencePaths))
+	{
+		ListAssetsForFilters(StoredAssetsData, ListedAssetsData);
+		SortListedAssetsData();
+		ApplySearchFilter();
+	}
+	else if(bItemsRemoved || ChangedItems.Num() > 0)
+	{
+		RelistChangedItems(ChangedItems);
+		RebuildAssetListRootItems();
+		RebuildFolderTree();
+	}
+
+	//Rows of items that are still displayed are kept, only rows for inserted or dropped items change
+	if(ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+
+	return EActiveTimerReturnType::Stop;
+}
+
+void SAdvancedDeleteTab::RelistChangedItems(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ChangedItems)
+{
+	TBitArray<> ChangedItemsMask(false, NextItemIndex);
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& ChangedItem : ChangedItems)
+	{
+		ChangedItemsMask[ChangedItem->ItemIndex] = true;
+	}
+
+	auto IsItemChanged = [&ChangedItemsMask](const TSharedPtr<FAdvancedDeleteListItem>& Item)
+	{
+		return ChangedItemsMask[Item->ItemIndex];
+	};
+
+	ListedAssetsData.RemoveAll(IsItemChanged);
+	DisplayedAssetsData.RemoveAll(IsItemChanged);
+
+	TArray<TSharedPtr<FAdvancedDeleteListItem>> RelistedItems;
+	ListAssetsForFilters(ChangedItems, RelistedItems);
+
+	//Only the changed items are sorted, both lists already are and they are merged into them
+	SortAssetItems(RelistedItems);
+
+	TArray<TSharedPtr<FAdvancedDeleteListItem>> RedisplayedItems;
+
+	if(SearchText.IsEmpty())
+	{
+		RedisplayedItems = RelistedItems;
+	}
+	else
+	{
+		TBitArray<> MatchingItems;
+		SearchIndex.Search(SearchText, MatchingItems);
+
+		for(const TSharedPtr<FAdvancedDeleteListItem>& Item : RelistedItems)
+		{
+			if(MatchingItems[Item->ItemIndex])
+			{
+				RedisplayedItems.Add(Item);
+			}
+		}
+	}
+
+	MergeIntoSortedItems(ListedAssetsData, MoveTemp(RelistedItems));
+	MergeIntoSortedItems(DisplayedAssetsData, MoveTemp(RedisplayedItems));
+}
+
+bool SAdvancedDeleteTab::IsAssetInScanFolders(const FAssetData& AssetData) const
+{
+	if(AssetData.IsRedirector()) return false;
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	if(SuperManagerModule.GetAssetPathFilter().IsPathExcluded(AssetData.PackagePath)) return false;
+
+	const FNameBuilder PackagePathBuilder(AssetData.PackagePath);
+	const FStringView PackagePath = PackagePathBuilder.ToView();
+
+	for(const FString& ScanFolderPath : ScanFolderPaths)
+	{
+		if(!PackagePath.StartsWith(ScanFolderPath)) continue;
+
+		//A folder only contains paths continuing with a slash, not siblings sharing its name as a prefix
+		if(PackagePath.Len() == ScanFolderPath.Len() || PackagePath[ScanFolderPath.Len()] == TEXT('/')) return true;
+	}
+
+	return false;
+}
+
+#pragma endregion
+
+#pragma region SearchBox
+
+TSharedRef<SWidget> SAdvancedDeleteTab::ConstructSearchBox()
+{
+	TSharedRef<SSearchBox> ConstructedSearchBox = SNew(SSearchBox)
+	.HintText(FText::FromString(TEXT("Search asset names and paths")))
+	.OnTextChanged(this, &SAdvancedDeleteTab::OnSearchTextChanged)
+	.OnTextCommitted(this, &SAdvancedDeleteTab::OnSearchTextCommitted);
+
+	return ConstructedSearchBox;
+}
+
+void SAdvancedDeleteTab::OnSearchTextChanged(const FText& InSearchText)
+{
+	PendingSearchText = InSearchText.ToString();
+
+	//Every keystroke restarts the delay
+	if(SearchDebounceTimerHandle.IsValid())
+	{
+		UnRegisterActiveTimer(SearchDebounceTimerHandle.ToSharedRef());
+	}
+
+	SearchDebounceTimerHandle = RegisterActiveTimer(SearchDebounceDelay,
+		FWidgetActiveTimerDelegate::CreateSP(this, &SAdvancedDeleteTab::OnSearchDebounceElapsed));
+}
+
+void SAdvancedDeleteTab::OnSearchTextCommitted(const FText& InSearchText, ETextCommit::Type CommitType)
+{
+	if(SearchDebounceTimerHandle.IsValid())
+	{
+		UnRegisterActiveTimer(SearchDebounceTimerHandle.ToSharedRef());
+		SearchDebounceTimerHandle.Reset();
+	}
+
+	PendingSearchText = InSearchText.ToString();
+	OnSearchDebounceElapsed(0.0, 0.f);
+}
+
+EActiveTimerReturnType SAdvancedDeleteTab::OnSearchDebounceElapsed(double InCurrentTime, float InDeltaTime)
+{
+	SearchDebounceTimerHandle.Reset();
+
+	if(PendingSearchText != SearchText)
+	{
+		SearchText = PendingSearchText;
+		ApplySearchFilter();
+
+		if(ConstructedAssetListView.IsValid())
+		{
+			ConstructedAssetListView->RequestListRefresh();
+		}
+	}
+
+	return EActiveTimerReturnType::Stop;
+}
+
+void SAdvancedDeleteTab::ApplySearchFilter()
+{
+	if(SearchText.IsEmpty())
+	{
+		DisplayedAssetsData = ListedAssetsData;
+	}
+	else
+	{
+		TBitArray<> MatchingItems;
+		SearchIndex.Search(SearchText, MatchingItems);
+
+		DisplayedAssetsData.Reset();
+
+		for(const TSharedPtr<FAdvancedDeleteListItem>& Item : ListedAssetsData)
+		{
+			if(MatchingItems[Item->ItemIndex])
+			{
+				DisplayedAssetsData.Add(Item);
+			}
+		}
+	}
+
+	RebuildAssetListRootItems();
+	RebuildFolderTree();
+}
+
+#pragma endregion
+
+#pragma region FolderTreeView
+
+TSharedRef<STreeView<TSharedPtr<FAdvancedDeleteFolderTreeItem>>> SAdvancedDeleteTab::ConstructFolderTreeView()
+{
+	ConstructedFolderTreeView = SNew(STreeView<TSharedPtr<FAdvancedDeleteFolderTreeItem>>)
+	.ItemHeight(24.f)
+	.TreeItemsSource(&FolderTreeRootItems)
+	.OnGenerateRow(this, &SAdvancedDeleteTab::OnGenerateRowForFolderTree)
+	.OnGetChildren(this, &SAdvancedDeleteTab::OnGetFolderTreeChildren)
+	.OnExpansionChanged(this, &SAdvancedDeleteTab::OnFolderTreeExpansionChanged);
+
+	return ConstructedFolderTreeView.ToSharedRef();
+}
+
+TSharedRef<SCheckBox> SAdvancedDeleteTab::ConstructFolderTreeToggle()
+{
+	TSharedRef<SCheckBox> ConstructedToggle = SNew(SCheckBox)
+	.Style(FCoreStyle::Get(), "ToggleButtonCheckbox")
+	.IsChecked_Lambda([this]()
+	{
+		return bShowFolderTree ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+	})
+	.OnCheckStateChanged(this, &SAdvancedDeleteTab::OnFolderTreeToggled)
+	[
+		SNew(STextBlock)
+		.Text(FText::FromString(TEXT("Folder Tree")))
+		.Margin(FMargin(5.f, 2.f))
+	];
+
+	return ConstructedToggle;
+}
+
+void SAdvancedDeleteTab::OnFolderTreeToggled(ECheckBoxState NewState)
+{
+	bShowFolderTree = NewState == ECheckBoxState::Checked;
+
+	RebuildFolderTree();
+}
+
+void SAdvancedDeleteTab::RebuildFolderTree()
+{
+	//The list view alone pays nothing for the tree
+	if(!bShowFolderTree || !ConstructedFolderTreeView.IsValid()) return;
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	FolderTree.Build(DisplayedAssetsData, SuperManagerModule.GetAssetReferenceGraph());
+
+	TArray<int32> RootNodeIndices;
+	FolderTree.GetRootNodeIndices(RootNodeIndices);
+
+	RootNodeIndices.Sort([this](int32 A, int32 B)
+	{
+		return FolderTree.GetNode(A).FolderPath.LexicalLess(FolderTree.GetNode(B).FolderPath);
+	});
+
+	FolderTreeRootItems.Reset();
+
+	for(const int32 RootNodeIndex : RootNodeIndices)
+	{
+		FolderTreeRootItems.Add(MakeShared<FAdvancedDeleteFolderTreeItem>(RootNodeIndex));
+	}
+
+	ConstructedFolderTreeView->ClearExpandedItems();
+	RestoreFolderExpansion(FolderTreeRootItems);
+
+	ConstructedFolderTreeView->RequestTreeRefresh();
+}
+
+void SAdvancedDeleteTab::CreateChildItems(const TSharedPtr<FAdvancedDeleteFolderTreeItem>& FolderItem)
+{
+	if(FolderItem->bChildItemsCreated) return;
+
+	FolderItem->bChildItemsCreated = true;
+
+	TArray<int32> ChildNodeIndices;
+	FolderTree.GetChildNodeIndices(FolderItem->NodeIndex, ChildNodeIndices);
+
+	ChildNodeIndices.Sort([this](int32 A, int32 B)
+	{
+		return FolderTree.GetNode(A).FolderPath.LexicalLess(FolderTree.GetNode(B).FolderPath);
+	});
+
+	FolderItem->ChildItems.Reserve(ChildNodeIndices.Num());
+
+	for(const int32 ChildNodeIndex : ChildNodeIndices)
+	{
+		FolderItem->ChildItems.Add(MakeShared<FAdvancedDeleteFolderTreeItem>(ChildNodeIndex));
+	}
+}
+
+void SAdvancedDeleteTab::RestoreFolderExpansion(const TArray<TSharedPtr<FAdvancedDeleteFolderTreeItem>>& FolderItems)
+{
+	//Only walks down expanded folders, the tree itself creates the first level below the folders it lists
+	for(const TSharedPtr<FAdvancedDeleteFolderTreeItem>& FolderItem : FolderItems)
+	{
+		if(!ExpandedFolderPaths.Contains(FolderTree.GetNode(FolderItem->NodeIndex).FolderPath)) continue;
+
+		ConstructedFolderTreeView->SetItemExpansion(FolderItem, true);
+
+		CreateChildItems(FolderItem);
+		RestoreFolderExpansion(FolderItem->ChildItems);
+	}
+}
+
+TSharedRef<ITableRow> SAdvancedDeleteTab::OnGenerateRowForFolderTree(TSharedPtr<FAdvancedDeleteFolderTreeItem> FolderItem,
+	const TSharedRef<STableViewBase>& OwnerTable)
+{
+	const FAdvancedDeleteFolderNode& FolderNode = FolderTree.GetNode(FolderItem->NodeIndex);
+
+	const FString FolderPath = FolderNode.FolderPath.ToString();
+	const FString FolderName = FolderNode.ParentIndex != INDEX_NONE ? FPaths::GetCleanFilename(FolderPath) : FolderPath;
+
+	FSlateFontInfo FolderNameFont = GetEmbossedTextFont();
+	FolderNameFont.Size = 12.f;
+
+	FSlateFontInfo FolderTotalsFont = GetEmbossedTextFont();
+	FolderTotalsFont.Size = 10.f;
+
+	const FString FolderTotalsText = FString::Printf(TEXT("%d assets, %d unused, %s"),
+		FolderNode.NumAssets, FolderNode.NumUnusedAssets, *FText::AsMemory(FolderNode.DiskSize).ToString());
+
+	return SNew(STableRow<TSharedPtr<FAdvancedDeleteFolderTreeItem>>, OwnerTable)
+	.Padding(FMargin(2.f))
+	[
+		SNew(SHorizontalBox)
+
+		+SHorizontalBox::Slot()
+		.FillWidth(.6f)
+		.VAlign(VAlign_Center)
+		[
+			ConstructTextForRowWidget(FolderName, FolderNameFont)
+		]
+
+		+SHorizontalBox::Slot()
+		.FillWidth(.4f)
+		.VAlign(VAlign_Center)
+		[
+			ConstructTextForRowWidget(FolderTotalsText, FolderTotalsFont)
+		]
+	];
+}
+
+void SAdvancedDeleteTab::OnGetFolderTreeChildren(TSharedPtr<FAdvancedDeleteFolderTreeItem> FolderItem,
+	TArray<TSharedPtr<FAdvancedDeleteFolderTreeItem>>& OutChildItems)
+{
+	//Asked for every folder the tree lists, expanded or not, to decide on its expander, so one level below each listed
+	//folder is created while the levels below collapsed folders are not
+	CreateChildItems(FolderItem);
+
+	OutChildItems = FolderItem->ChildItems;
+}
+
+void SAdvancedDeleteTab::OnFolderTreeExpansionChanged(TSharedPtr<FAdvancedDeleteFolderTreeItem> FolderItem, bool bIsExpanded)
+{
+	const FName FolderPath = FolderTree.GetNode(FolderItem->NodeIndex).FolderPath;
+
+	if(bIsExpanded)
+	{
+		ExpandedFolderPaths.Add(FolderPath);
+	}
+	else
+	{
+		ExpandedFolderPaths.Remove(FolderPath);
+	}
+}
+
+#pragma endregion
+
+#pragma region ListingFilters
+
+TSharedRef<SComboButton> SAdvancedDeleteTab::ConstructFilterComboButton()
+{
+	TSharedRef<SComboButton> ConstructedComboButton = SNew(SComboButton)
+	.OnGetMenuContent(this, &SAdvancedDeleteTab::OnGetFilterMenuContent)
+	.ButtonContent()
+	[
+		SNew(STextBlock)
+		.Text_Lambda([this]()
+		{
+			return ActiveFiltersText;
+		})
+	];
+
+	return ConstructedComboButton;
+}
+
+TSharedRef<SWidget> SAdvancedDeleteTab::OnGetFilterMenuContent()
+{
+	//The menu stays open, so several filters can be combined in one go
+	FMenuBuilder MenuBuilder(false, nullptr);
+
+	for(int32 FilterIndex = 0; FilterIndex < FilterPipeline.GetNumFilters(); ++FilterIndex)
+	{
+		MenuBuilder.AddMenuEntry
+		(
+			FilterPipeline.GetFilter(FilterIndex).GetDisplayName(),
+			FText::GetEmpty(),
+			FSlateIcon(),
+			FUIAction
+			(
+				FExecuteAction::CreateSP(this, &SAdvancedDeleteTab::OnFilterToggled, FilterIndex),
+				FCanExecuteAction(),
+				FIsActionChecked::CreateLambda([this, FilterIndex]()
+				{
+					return FilterPipeline.IsFilterActive(FilterIndex);
+				})
+			),
+			NAME_None,
+			EUserInterfaceActionType::ToggleButton
+		);
+	}
+
+	return MenuBuilder.MakeWidget();
+}
+
+void SAdvancedDeleteTab::OnFilterToggled(int32 FilterIndex)
+{
+	FilterPipeline.SetFilterActive(FilterIndex, !FilterPipeline.IsFilterActive(FilterIndex));
+	ActiveFiltersText = FilterPipeline.GetActiveFiltersText();
+
+	StartContentHashingIfNeeded();
+	StartTextureHashingIfNeeded();
+	StartGeometryHashingIfNeeded();
+
+	ListAssetsForFilters(StoredAssetsData, ListedAssetsData);
+	SortListedAssetsData();
+	ApplySearchFilter();
+	RefreshAssetListView();
+}
+
+void SAdvancedDeleteTab::ListAssetsForFilters(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& AssetDataToFilter,
+	TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutAssetsData)
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	const FAdvancedDeleteFilterContext FilterContext(StoredAssetsData, SuperManagerModule.GetAssetReferenceGraph(), NextItemIndex);
+
+	OutAssetsData.Reset();
+	FilterPipeline.Evaluate(AssetDataToFilter, FilterContext, OutAssetsData);
+}
+
+void SAdvancedDeleteTab::RelistForChangedInputs(EAdvancedDeleteFilterInputs ChangedInputs)
+{
+	FilterPipeline.InvalidateInputs(ChangedInputs);
+
+	if(!FilterPipeline.DoActiveFiltersRead(ChangedInputs)) return;
+
+	ListAssetsForFilters(StoredAssetsData, ListedAssetsData);
+	SortListedAssetsData();
+	ApplySearchFilter();
+
+	if(ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+}
+
+TSharedRef<STextBlock> SAdvancedDeleteTab::ConstructComboHelpTexts(const FString& TextContent,
+	ETextJustify::Type TextJustify)
+{
+	TSharedRef<STextBlock> ConstructedHelpText = SNew(STextBlock)
+	.Text(FText::FromString(TextContent))
+	.Justification(TextJustify)
+	.AutoWrapText(true);
+
+	return ConstructedHelpText;
+}
+
+#pragma endregion
+
+#pragma region RowWidgetForAssetListView
+
+TSharedRef<ITableRow> SAdvancedDeleteTab::OnGenerateRowForList(TSharedPtr<FAdvancedDeleteListItem> AssetDataToDisplay,
+                                                               const TSharedRef<STableViewBase>& OwnerTable)
+{
+	//Released rows keep their cells, handing them the new item only swaps the cached texts
+	if(RecycledRows.Num() > 0)
+	{
+		TSharedRef<SAssetDeleteRow> RecycledRow = RecycledRows.Pop(EAllowShrinking::No);
+		RecycledRow->SetItem(AssetDataToDisplay);
+
+		return RecycledRow;
+	}
+
+	++NumConstructedRows;
+
+	TSharedRef<SAssetDeleteRow> ListViewRowWidget = SNew(SAssetDeleteRow, OwnerTable)
+	.Item(AssetDataToDisplay)
+	.RowStyle(RowStyle)
+	.IsItemChecked(this, &SAdvancedDeleteTab::IsItemChecked)
+	.OnItemCheckChanged(this, &SAdvancedDeleteTab::SetItemChecked)
+	.OnItemDeleteClicked(this, &SAdvancedDeleteTab::OnDeleteButtonClicked)
+	.OnGetFolderToolTip(this, &SAdvancedDeleteTab::GetFolderSizeTotalsText)
+	.OnGenerateThumbnail(this, &SAdvancedDeleteTab::ConstructThumbnailForRowWidget)
+	.OnGetGroupSize(this, &SAdvancedDeleteTab::GetDuplicateGroupSize);
+
+	return ListViewRowWidget;
+}
+
+void SAdvancedDeleteTab::OnAssetRowReleased(const TSharedRef<ITableRow>& ReleasedRow)
+{
+	TSharedRef<SAssetDeleteRow> ReleasedAssetRow = StaticCastSharedRef<SAssetDeleteRow>(ReleasedRow->AsWidget());
+	ReleasedAssetRow->ReleaseItem();
+
+	RecycledRows.Add(ReleasedAssetRow);
+}
+
+void SAdvancedDeleteTab::SetItemChecked(const TSharedPtr<FAdvancedDeleteListItem>& Item, bool bIsChecked)
+{
+	CheckedItems[Item->ItemIndex] = bIsChecked;
+}
+
+void SAdvancedDeleteTab::OnRowWidgetMouseButtonClicked(TSharedPtr<FAdvancedDeleteListItem> ClickedData)
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>("SuperManager");
+
+	SuperManagerModule.SyncSBToClickedAssetForAssetList(ClickedData->AssetData.ObjectPath.ToString());
+}
+
+TSharedRef<STextBlock> SAdvancedDeleteTab::ConstructTextForRowWidget(const FString& TextContent,
+	const FSlateFontInfo& FontToUse)
+{
+	TSharedRef<STextBlock> ConstructedTextBlock = SNew(STextBlock)
+	.Text(FText::FromString(TextContent))
+	.Font(FontToUse)
+	.ColorAndOpacity(FColor::White);
+
+	return ConstructedTextBlock;
+}
+
+FReply SAdvancedDeleteTab::OnDeleteButtonClicked(TSharedPtr<FAdvancedDeleteListItem> ClickedAssetData)
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>("SuperManager");
+	
+	const bool bAssetDeleted = SuperManagerModule.DeleteSingleAssetForAssetList(ClickedAssetData->AssetData);
+
+	if(bAssetDeleted)
+	{
+		RemoveDeletedItems({ ClickedAssetData->AssetData.GetSoftObjectPath() });
+
+		if(ConstructedAssetListView.IsValid())
+		{
+			ConstructedAssetListView->RequestListRefresh();
+		}
+	}
+	
+	return FReply::Handled();
+}
+
+#pragma endregion
+
+#pragma region TabButtons
+
+TSharedRef<SButton> SAdvancedDeleteTab::ConstructDeleteAllButton()
+{
+	TSharedRef<SButton> DeleteAllButton = SNew(SButton)
+	.ContentPadding(FMargin(5.f))
+	.OnClicked(this, &SAdvancedDeleteTab::OnDeleteAllButtonClicked);
+
+	DeleteAllButton->SetContent(ConstructTextForTabButtons(TEXT("Delete All")));
+
+	return DeleteAllButton;
+}
+
+FReply SAdvancedDeleteTab::OnDeleteAllButtonClicked()
+{
+	if(CheckedItems.Find(true) == INDEX_NONE)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No assets curently selected"));
+		return FReply::Handled();
+	}
+
+	TArray<FAssetData> AssetDataToDelete;
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& Item : DisplayedAssetsData)
+	{
+		if(IsItemChecked(Item))
+		{
+			AssetDataToDelete.Add(Item->AssetData);
+		}
+	}
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>("SuperManager");
+
+	TSet<FSoftObjectPath> DeletedAssetPaths;
+	const bool bAssetDataDeleted = SuperManagerModule.DeleteMultipleAssetsForAssetsList(AssetDataToDelete, DeletedAssetPaths);
+
+	if(bAssetDataDeleted)
+	{
+		RemoveDeletedItems(DeletedAssetPaths);
+
+		if(ConstructedAssetListView.IsValid())
+		{
+			ConstructedAssetListView->RequestListRefresh();
 		}
 	}
 	
 	return FReply::Handled();
 }
 
+TSharedRef<SButton> SAdvancedDeleteTab::ConstructSelectAllButton()
+{
+	TSharedRef<SButton> SelectAllButton = SNew(SButton)
+	.ContentPadding(FMargin(5.f))
+	.OnClicked(this, &SAdvancedDeleteTab::OnSelectAllButtonClicked);
+
+	SelectAllButton->SetContent(ConstructTextForTabButtons(TEXT("Select All")));
+
+	return SelectAllButton;
+}
+
+FReply SAdvancedDeleteTab::OnSelectAllButtonClicked()
+{
+	for(const TSharedPtr<FAdvancedDeleteListItem>& Item : DisplayedAssetsData)
+	{
+		CheckedItems[Item->ItemIndex] = true;
+	}
+
+	return FReply::Handled();
+}
+
+TSharedRef<SButton> SAdvancedDeleteTab::ConstructDeselectAllButton()
+{
+	TSharedRef<SButton> DeselectAllButton = SNew(SButton)
+	.ContentPadding(FMargin(5.f))
+	.OnClicked(this, &SAdvancedDeleteTab::OnDeselectAllButtonClicked);
+
+	DeselectAllButton->SetContent(ConstructTextForTabButtons(TEXT("Deselect All")));
+
+	return DeselectAllButton;
+}
+
+FReply SAdvancedDeleteTab::OnDeselectAllButtonClicked()
+{
+	CheckedItems.SetRange(0, CheckedItems.Num(), false);
+	
+	return FReply::Handled();
+}
+
+TSharedRef<SButton> SAdvancedDeleteTab::ConstructConsolidateButton()
+{
+	TSharedRef<SButton> ConsolidateButton = SNew(SButton)
+	.ContentPadding(FMargin(5.f))
+	.IsEnabled(this, &SAdvancedDeleteTab::CanConsolidateDuplicateGroups)
+	.ToolTipText(FText::FromString(TEXT("Keeps the most referenced asset of every displayed Same Content or Same Geometry group and retargets references to the others to it")))
+	.OnClicked(this, &SAdvancedDeleteTab::OnConsolidateButtonClicked);
+
+	ConsolidateButton->SetContent(ConstructTextForTabButtons(TEXT("Consolidate")));
+
+	return ConsolidateButton;
+}
+
+bool SAdvancedDeleteTab::CanConsolidateDuplicateGroups() const
+{
+	//Similar looks and shared names are no proof the assets are interchangeable, only identical contents or geometry are
+	const bool bGroupsAreExact = FilterPipeline.IsFilterActive(AdvancedDeleteFilterIds::SameContent)
+		|| FilterPipeline.IsFilterActive(AdvancedDeleteFilterIds::SameGeometry);
+
+	return bGroupsAreExact && DuplicateGroupMembers.Num() > 0;
+}
+
+FReply SAdvancedDeleteTab::OnConsolidateButtonClicked()
+{
+	if(!CanConsolidateDuplicateGroups()) return FReply::Handled();
+
+	TArray<TArray<FAssetData>> DuplicateGroups;
+	bool bConsolidateRemainingGroups = false;
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& RootItem : AssetListRootItems)
+	{
+		const TArray<TSharedPtr<FAdvancedDeleteListItem>>* GroupMembers = DuplicateGroupMembers.Find(RootItem->ItemIndex);
+
+		if(!GroupMembers) continue;
+
+		//The most referenced asset is kept, so the fewest references need retargeting, ties keep the displayed order
+		TSharedPtr<FAdvancedDeleteListItem> KeptItem = RootItem;
+
+		for(const TSharedPtr<FAdvancedDeleteListItem>& GroupMember : *GroupMembers)
+		{
+			if(GroupMember->ReferencerCount > KeptItem->ReferencerCount) KeptItem = GroupMember;
+		}
+
+		TArray<FAssetData> DuplicateGroup;
+		DuplicateGroup.Add(KeptItem->AssetData);
+
+		if(RootItem != KeptItem) DuplicateGroup.Add(RootItem->AssetData);
+
+		for(const TSharedPtr<FAdvancedDeleteListItem>& GroupMember : *GroupMembers)
+		{
+			if(GroupMember != KeptItem) DuplicateGroup.Add(GroupMember->AssetData);
+		}
+
+		if(!bConsolidateRemainingGroups)
+		{
+			FString ConfirmMessage = TEXT("Keep ") + DuplicateGroup[0].GetObjectPathString() + TEXT(" and retarget references to these duplicates before removing them?\n");
+
+			const int32 NumListedDuplicates = FMath::Min(DuplicateGroup.Num() - 1, ConsolidateConfirmMaxListedAssets);
+
+			for(int32 AssetIndex = 1; AssetIndex <= NumListedDuplicates; ++AssetIndex)
+			{
+				ConfirmMessage += TEXT("\n") + DuplicateGroup[AssetIndex].GetObjectPathString();
+			}
+
+			if(DuplicateGroup.Num() - 1 > NumListedDuplicates)
+			{
+				ConfirmMessage += TEXT("\n...and ") + FString::FromInt(DuplicateGroup.Num() - 1 - NumListedDuplicates) + TEXT(" more");
+			}
+
+			const EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNoYesAllNoAllCancel, ConfirmMessage);
+
+			if(ConfirmResult == EAppReturnType::Cancel) return FReply::Handled();
+
+			if(ConfirmResult == EAppReturnType::NoAll) break;
+
+			if(ConfirmResult == EAppReturnType::No) continue;
+
+			bConsolidateRemainingGroups = ConfirmResult == EAppReturnType::YesAll;
+		}
+
+		DuplicateGroups.Add(MoveTemp(DuplicateGroup));
+	}
+
+	if(DuplicateGroups.Num() == 0) return FReply::Handled();
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>("SuperManager");
+
+	TSet<FSoftObjectPath> ConsolidatedAssetPaths;
+
+	if(SuperManagerModule.ConsolidateDuplicatesForAssetList(DuplicateGroups, ConsolidatedAssetPaths))
+	{
+		RemoveDeletedItems(ConsolidatedAssetPaths);
+
+		if(ConstructedAssetListView.IsValid())
+		{
+			ConstructedAssetListView->RequestListRefresh();
+		}
+	}
+
+	return FReply::Handled();
+}
+
 TSharedRef<STextBlock> SAdvancedDeleteTab::ConstructTextForTabButtons(const FString& TextContent)
 {
 	FSlateFontInfo ButtonTextFont = GetEmbossedTextFont();
@@ -0,0 +1,262 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SlateWidgets/AssetDeleteRow.h"
+#include "Styling/AppStyle.h"
+#include "Widgets/Views/SExpanderArrow.h"
+
+FAssetDeleteRowStyle::FAssetDeleteRowStyle()
+{
+	NameFont = FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
+	NameFont.Size = 15.f;
+
+	ColumnFont = FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
+	ColumnFont.Size = 10.f;
+
+	CheckBoxStyle = &FAppStyle::Get().GetWidgetStyle<FCheckBoxStyle>("Checkbox");
+	DeleteButtonStyle = &FAppStyle::Get().GetWidgetStyle<FButtonStyle>("Button");
+
+	DeleteText = FText::FromString(TEXT("Delete"));
+	PendingText = FText::FromString(TEXT("..."));
+	UnknownText = FText::FromString(TEXT("-"));
+
+	GroupNameFormat = FText::FromString(TEXT("{0} ({1})"));
+}
+
+void SAssetDeleteRow::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	RowStyle = InArgs._RowStyle;
+
+	IsItemChecked = InArgs._IsItemChecked;
+	OnItemCheckChanged = InArgs._OnItemCheckChanged;
+	OnItemDeleteClicked = InArgs._OnItemDeleteClicked;
+	OnGetFolderToolTip = InArgs._OnGetFolderToolTip;
+	OnGenerateThumbnail = InArgs._OnGenerateThumbnail;
+	OnGetGroupSize = InArgs._OnGetGroupSize;
+
+	//The item has to be in place before the cells are generated
+	SetItem(InArgs._Item);
+
+	FSuperRowType::Construct(FSuperRowType::FArguments().Padding(FMargin(2.f)), OwnerTable);
+}
+
+TSharedRef<SWidget> SAssetDeleteRow::GenerateWidgetForColumn(const FName& ColumnName)
+{
+	if(ColumnName == AdvancedDeleteColumns::CheckBox)
+	{
+		return SNew(SCheckBox)
+		.Style(RowStyle->CheckBoxStyle)
+		.Type(ESlateCheckBoxType::CheckBox)
+		.IsChecked(this, &SAssetDeleteRow::GetCheckBoxState)
+		.OnCheckStateChanged(this, &SAssetDeleteRow::OnCheckBoxStateChanged);
+	}
+
+	if(ColumnName == AdvancedDeleteColumns::Thumbnail)
+	{
+		SAssignNew(ThumbnailBox, SBox);
+		RefreshThumbnail();
+
+		return ThumbnailBox.ToSharedRef();
+	}
+
+	//The expander arrow only shows on rows rooting a duplicate group, other rows keep its indent
+	if(ColumnName == AdvancedDeleteColumns::Name)
+	{
+		return SNew(SHorizontalBox)
+
+		+SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		[
+			SNew(SExpanderArrow, SharedThis(this))
+		]
+
+		+SHorizontalBox::Slot()
+		.FillWidth(1.f)
+		.VAlign(VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Font(RowStyle->NameFont)
+			.ColorAndOpacity(FColor::White)
+			.Text(this, &SAssetDeleteRow::GetNameText)
+		];
+	}
+
+	if(ColumnName == AdvancedDeleteColumns::Class)
+	{
+		return SNew(STextBlock)
+		.Font(RowStyle->ColumnFont)
+		.ColorAndOpacity(FColor::White)
+		.Text_Lambda([this]() { return ClassText; });
+	}
+
+	if(ColumnName == AdvancedDeleteColumns::Path)
+	{
+		return SNew(STextBlock)
+		.Font(RowStyle->ColumnFont)
+		.ColorAndOpacity(FColor::White)
+		.Text_Lambda([this]() { return PathText; })
+		.ToolTipText(this, &SAssetDeleteRow::GetPathToolTipText);
+	}
+
+	if(ColumnName == AdvancedDeleteColumns::DiskSize)
+	{
+		return SNew(STextBlock)
+		.Font(RowStyle->ColumnFont)
+		.ColorAndOpacity(FColor::White)
+		.Text(this, &SAssetDeleteRow::GetDiskSizeText);
+	}
+
+	if(ColumnName == AdvancedDeleteColumns::MemorySize)
+	{
+		return SNew(STextBlock)
+		.Font(RowStyle->ColumnFont)
+		.ColorAndOpacity(FColor::White)
+		.Text(this, &SAssetDeleteRow::GetMemorySizeText);
+	}
+
+	if(ColumnName == AdvancedDeleteColumns::Referencers)
+	{
+		return SNew(STextBlock)
+		.Font(RowStyle->ColumnFont)
+		.ColorAndOpacity(FColor::White)
+		.Text(this, &SAssetDeleteRow::GetReferencersText);
+	}
+
+	if(ColumnName == AdvancedDeleteColumns::LastModified)
+	{
+		return SNew(STextBlock)
+		.Font(RowStyle->ColumnFont)
+		.ColorAndOpacity(FColor::White)
+		.Text(this, &SAssetDeleteRow::GetLastModifiedText);
+	}
+
+	if(ColumnName == AdvancedDeleteColumns::Delete)
+	{
+		return SNew(SButton)
+		.ButtonStyle(RowStyle->DeleteButtonStyle)
+		.Text(RowStyle->DeleteText)
+		.OnClicked(this, &SAssetDeleteRow::OnDeleteButtonClicked);
+	}
+
+	return SNullWidget::NullWidget;
+}
+
+void SAssetDeleteRow::SetItem(const TSharedPtr<FAdvancedDeleteListItem>& InItem)
+{
+	Item = InItem;
+
+	AssetNameText = FText::FromName(Item->AssetData.AssetName);
+	ClassText = FText::FromName(Item->AssetData.AssetClassPath.GetAssetName());
+	PathText = FText::FromName(Item->AssetData.PackagePath);
+
+	//Value texts start out as they read for an item without values and are rebuilt on the first read that differs
+	DiskSizeText = MemorySizeText = FCachedSizeText{ false, -1, RowStyle->PendingText };
+
+	CachedGroupSize = INDEX_NONE;
+	CachedReferencerCount = INDEX_NONE;
+
+	CachedLastModified = FDateTime::MinValue();
+	LastModifiedText = RowStyle->UnknownText;
+
+	RefreshThumbnail();
+}
+
+void SAssetDeleteRow::ReleaseItem()
+{
+	if(ThumbnailBox.IsValid())
+	{
+		ThumbnailBox->SetContent(SNullWidget::NullWidget);
+	}
+}
+
+void SAssetDeleteRow::RefreshThumbnail()
+{
+	if(!ThumbnailBox.IsValid() || !Item.IsValid()) return;
+
+	ThumbnailBox->SetContent(OnGenerateThumbnail.IsBound() ? OnGenerateThumbnail.Execute(Item) : SNullWidget::NullWidget);
+}
+
+ECheckBoxState SAssetDeleteRow::GetCheckBoxState() const
+{
+	return Item.IsValid() && IsItemChecked.Execute(Item) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
+void SAssetDeleteRow::OnCheckBoxStateChanged(ECheckBoxState NewState)
+{
+	OnItemCheckChanged.ExecuteIfBound(Item, NewState == ECheckBoxState::Checked);
+}
+
+FReply SAssetDeleteRow::OnDeleteButtonClicked()
+{
+	return OnItemDeleteClicked.IsBound() ? OnItemDeleteClicked.Execute(Item) : FReply::Handled();
+}
+
+FText SAssetDeleteRow::GetPathToolTipText() const
+{
+	//Only evaluated while the tooltip is open
+	return OnGetFolderToolTip.IsBound() ? OnGetFolderToolTip.Execute(Item->AssetData.PackagePath) : FText::GetEmpty();
+}
+
+FText SAssetDeleteRow::GetDiskSizeText()
+{
+	return RefreshSizeText(DiskSizeText, Item->DiskSize);
+}
+
+FText SAssetDeleteRow::GetMemorySizeText()
+{
+	return RefreshSizeText(MemorySizeText, Item->MemorySize);
+}
+
+const FText& SAssetDeleteRow::RefreshSizeText(FCachedSizeText& SizeText, int64 Size)
+{
+	if(SizeText.bSizeCalculated != Item->bSizesCalculated || SizeText.Size != Size)
+	{
+		SizeText.bSizeCalculated = Item->bSizesCalculated;
+		SizeText.Size = Size;
+
+		if(!SizeText.bSizeCalculated) SizeText.Text = RowStyle->PendingText;
+		else SizeText.Text = Size >= 0 ? FText::AsMemory(Size) : RowStyle->UnknownText;
+	}
+
+	return SizeText.Text;
+}
+
+FText SAssetDeleteRow::GetNameText()
+{
+	const int32 GroupSize = OnGetGroupSize.IsBound() ? OnGetGroupSize.Execute(Item) : 0;
+
+	if(GroupSize != CachedGroupSize)
+	{
+		CachedGroupSize = GroupSize;
+		NameText = GroupSize > 0 ? FText::Format(RowStyle->GroupNameFormat, AssetNameText, GroupSize) : AssetNameText;
+	}
+
+	return NameText;
+}
+
+FText SAssetDeleteRow::GetReferencersText()
+{
+	if(Item->ReferencerCount != CachedReferencerCount)
+	{
+		CachedReferencerCount = Item->ReferencerCount;
+		ReferencersText = FText::AsNumber(CachedReferencerCount);
+	}
+
+	return ReferencersText;
+}
+
+FText SAssetDeleteRow::GetLastModifiedText()
+{
+	if(Item->LastModified != CachedLastModified)
+	{
+		CachedLastModified = Item->LastModified;
+
+		//Package timestamps are UTC
+		LastModifiedText = CachedLastModified != FDateTime::MinValue() ?
+			FText::FromString((CachedLastModified + (FDateTime::Now() - FDateTime::UtcNow())).ToString(TEXT("%Y-%m-%d %H:%M"))) :
+			RowStyle->UnknownText;
+	}
+
+	return LastModifiedText;
+}
@@ -8,6 +8,7 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetToolsModule.h"
 #include "SlateWidgets/AdvancedDeleteWidget.h"
+#include "AssetScanning/AsyncAssetDataGatherer.h"
 #include "CustomStyle/SuperManagerStyle.h"
 #include "LevelEditor.h"
 #include "Engine/Selection.h"
@@ -15,11 +16,30 @@
 #include "CustomUICommands/SuperManagerUICommands.h"
 #include "SceneOutlinerModule.h"
 #include "CustomOutlinerColumn/OutlinerSelectionColumn.h"
+#include "Settings/SuperManagerSettings.h"
+#include "Settings/ProjectPackagingSettings.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Async/ParallelFor.h"
+#include "FileHelpers.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/MetaData.h"
+#include "Serialization/MemoryWriter.h"
+#include "Algo/Sort.h"
 
 #define LOCTEXT_NAMESPACE "FSuperManagerModule"
 
 void FSuperManagerModule::StartupModule()
 {
+	InitAssetPathFilter();
+
+	InitAssetReferenceTracking();
+
+	//Commandlets run without Slate or a level editor, only the scanning side of the module is needed there
+	if(IsRunningCommandlet()) return;
+
 	FSuperManagerStyle::InitializeIcons();
 	
 	InitCBMenuExtention();
@@ -99,28 +119,17 @@ void FSuperManagerModule::AddCBMenuEntry(FMenuBuilder& MenuBuilder)
 
 void FSuperManagerModule::OnDeleteUnusedAssetsButtonClicked()
 {
-	if(ConstructedDockTab.IsValid())
-	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("Please close advanced delete tab before this operation"));
-		return;
-	}
-	
-	if(FolderPathsSelected.Num() > 1)
-	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok ,TEXT("You can only do this to one folder"));
-		return;
-	}
-
-	TArray<FString> AssetsPathNames = UEditorAssetLibrary::ListAssets(FolderPathsSelected[0]);
+	TArray<FAssetData> AssetsDataUnderFolders;
+	GatherAssetDataUnderFolders(FolderPathsSelected, AssetsDataUnderFolders);
 
-	if(AssetsPathNames.Num() == 0)
+	if(AssetsDataUnderFolders.Num() == 0)
 	{
 		DebugHeader::ShowMsgDialog(EAppMsgType::Ok ,TEXT("No assets found"));
 		return;
 	}
 
 	EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
-		TEXT("A total of ") + FString::FromInt(AssetsPathNames.Num()) + TEXT(" found. \nWould you like to procceed?"));
+		TEXT("A total of ") + FString::FromInt(AssetsDataUnderFolders.Num()) + TEXT(" found. \nWould you like to procceed?"));
 
 	if(ConfirmResult == EAppReturnType::No) return;
 
@@ -128,22 +137,10 @@ void FSuperManagerModule::OnDeleteUnusedAssetsButtonClicked()
 	
 	TArray<FAssetData> UnusedAssetsDataArray;
 
-	for(const FString& AssetPathName : AssetsPathNames)
+	if(!ScanForUnusedAssets(AssetsDataUnderFolders, UnusedAssetsDataArray))
 	{
-		if (AssetPathName.Contains(TEXT("Developers")) || AssetPathName.Contains(TEXT("Collections")))
-		{
-			continue;
-		}
-
-		if(!UEditorAssetLibrary::DoesAssetExist(AssetPathName)) continue;
-
-		TArray<FString> AssetReferencers = UEditorAssetLibrary::FindPackageReferencersForAsset(AssetPathName);
-
-		if (AssetReferencers.Num() == 0)
-		{
-			const FAssetData UnusedAssetData = UEditorAssetLibrary::FindAssetData(AssetPathName);
-			UnusedAssetsDataArray.Add(UnusedAssetData);
-		}
+		DebugHeader::ShowNotifyInfo(TEXT("Unused assets scan cancelled"));
+		return;
 	}
 
 	if(UnusedAssetsDataArray.Num() > 0)
@@ -156,38 +153,78 @@ void FSuperManagerModule::OnDeleteUnusedAssetsButtonClicked()
 	}
 }
 
-void FSuperManagerModule::OnDeleteEmptyFoldersButtonClicked()
+bool FSuperManagerModule::ScanForUnusedAssets(const TArray<FAssetData>& AssetsData, TArray<FAssetData>& OutUnusedAssetsData)
 {
-	if(ConstructedDockTab.IsValid())
+	OutUnusedAssetsData.Empty();
+
+	const FAssetReferenceGraph& ReferenceGraph = GetAssetReferenceGraph();
+
+	//Shards are scanned in waves of one shard per thread, so the progress bar and cancel button are serviced between waves
+	const int32 ShardSize = 1024;
+	const int32 NumShards = FMath::DivideAndRoundUp(AssetsData.Num(), ShardSize);
+	const int32 NumShardsPerWave = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+
+	TArray<TArray<FAssetData>> ShardsUnusedAssetsData;
+	ShardsUnusedAssetsData.SetNum(NumShards);
+
+	FScopedSlowTask ScanSlowTask(NumShards, FText::FromString(TEXT("Scanning for unused assets")));
+	ScanSlowTask.MakeDialog(true);
+
+	for(int32 FirstShardInWave = 0; FirstShardInWave < NumShards; FirstShardInWave += NumShardsPerWave)
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok,TEXT("Please close advanced delete tab before this operation"));
-		return;
+		if(ScanSlowTask.ShouldCancel()) return false;
+
+		const int32 NumShardsInWave = FMath::Min(NumShardsPerWave, NumShards - FirstShardInWave);
+
+		ParallelFor(NumShardsInWave, [&](int32 ShardIndexInWave)
+		{
+			const int32 ShardIndex = FirstShardInWave + ShardIndexInWave;
+			const int32 ShardEnd = FMath::Min((ShardIndex + 1) * ShardSize, AssetsData.Num());
+
+			TArray<FAssetData>& ShardUnusedAssetsData = ShardsUnusedAssetsData[ShardIndex];
+
+			for(int32 AssetIndex = ShardIndex * ShardSize; AssetIndex < ShardEnd; ++AssetIndex)
+			{
+				const FAssetData& AssetData = AssetsData[AssetIndex];
+
+				if(AssetPathFilter.IsPathExcluded(AssetData.PackagePath))
+				{
+					continue;
+				}
+
+				if(ReferenceGraph.IsAssetUnreferenced(AssetData))
+				{
+					ShardUnusedAssetsData.Add(AssetData);
+				}
+			}
+		});
+
+		ScanSlowTask.EnterProgressFrame(NumShardsInWave);
 	}
-	
+
+	for(TArray<FAssetData>& ShardUnusedAssetsData : ShardsUnusedAssetsData)
+	{
+		OutUnusedAssetsData.Append(MoveTemp(ShardUnusedAssetsData));
+	}
+
+	return true;
+}
+
+void FSuperManagerModule::OnDeleteEmptyFoldersButtonClicked()
+{
 	UpdateRedirectors();
 	
-	TArray<FString> FolderPathsArray = UEditorAssetLibrary::ListAssets(FolderPathsSelected[0], true, true);
 	uint32 Counter = 0;
 
 	FString EmptyFolderPathsNames;
 	TArray<FString> EmptyFoldersPathsArray;
 
-	for(const FString& FolderPath : FolderPathsArray)
-	{
-		if(FolderPath.Contains(TEXT("Developers")) || FolderPath.Contains(TEXT("Collections")))
-		{
-			continue;
-		}
-		
-		if(!UEditorAssetLibrary::DoesDirectoryExist(FolderPath)) continue;
-
-		if(!UEditorAssetLibrary::DoesDirectoryHaveAssets(FolderPath))
-		{
-			EmptyFolderPathsNames.Append(FolderPath);
-			EmptyFolderPathsNames.Append(TEXT("\n"));
+	ListEmptyFoldersUnderFolders(FolderPathsSelected, EmptyFoldersPathsArray);
 
-			EmptyFoldersPathsArray.Add(FolderPath);
-		}
+	for(const FString& EmptyFolderPath : EmptyFoldersPathsArray)
+	{
+		EmptyFolderPathsNames.Append(EmptyFolderPath);
+		EmptyFolderPathsNames.Append(TEXT("\n"));
 	}
 
 	if(EmptyFoldersPathsArray.Num() == 0)
@@ -213,10 +250,62 @@ void FSuperManagerModule::OnDeleteEmptyFoldersButtonClicked()
 	}
 }
 
+void FSuperManagerModule::ListEmptyFoldersUnderFolders(const TArray<FString>& FolderPaths, TArray<FString>& OutEmptyFolderPaths)
+{
+	OutEmptyFolderPaths.Empty();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FString> RootFolderPaths;
+	CollapseNestedFolderPaths(FolderPaths, RootFolderPaths);
+
+	//Unfiltered on purpose, a folder holding only excluded assets or redirectors is not empty
+	TArray<FAssetData> AssetsDataUnderFolders;
+	QueryAssetDataUnderFolders(RootFolderPaths, AssetsDataUnderFolders);
+
+	TSet<FName> NonEmptyFolderPaths;
+
+	for(const FAssetData& AssetData : AssetsDataUnderFolders)
+	{
+		FString FolderPath = AssetData.PackagePath.ToString();
+
+		//Ancestors are marked too, stopping at the first one a previous asset already marked
+		while(!FolderPath.IsEmpty())
+		{
+			bool bAlreadyMarked = false;
+			NonEmptyFolderPaths.Add(FName(FolderPath), &bAlreadyMarked);
+
+			if(bAlreadyMarked) break;
+
+			int32 LastSlashIndex = INDEX_NONE;
+			if(!FolderPath.FindLastChar(TEXT('/'), LastSlashIndex) || LastSlashIndex == 0) break;
+
+			FolderPath.LeftInline(LastSlashIndex);
+		}
+	}
+
+	for(const FString& RootFolderPath : RootFolderPaths)
+	{
+		TArray<FString> SubFolderPaths;
+		AssetRegistry.GetSubPaths(RootFolderPath, SubFolderPaths, true);
+
+		for(const FString& SubFolderPath : SubFolderPaths)
+		{
+			if(AssetPathFilter.IsPathExcluded(SubFolderPath))
+			{
+				continue;
+			}
+
+			if(!NonEmptyFolderPaths.Contains(FName(SubFolderPath)))
+			{
+				OutEmptyFolderPaths.Add(SubFolderPath);
+			}
+		}
+	}
+}
+
 void FSuperManagerModule::OnAdvancedDeleteButtonClick()
 {
-	UpdateRedirectors();
-	
 	FGlobalTabmanager::Get()->TryInvokeTab(FName("AdvancedDelete"));
 }
 
@@ -267,8 +356,9 @@ TSharedRef<SDockTab> FSuperManagerModule::OnSpawnAdvancedDeleteTab(const FSpawnT
 	SNew(SDockTab).TabRole(ETabRole::NomadTab)
 	[
 		SNew(SAdvancedDeleteTab)
-		.AssetsDataToStore(GetAllAssetDataUnderSelectedFolder())
-		.CurrentSelectedFolder(FolderPathsSelected[0])
+		.AssetDataGatherer(StartGatheringAssetDataUnderFolders(FolderPathsSelected))
+		.ScanFolderPaths(FolderPathsSelected)
+		.CurrentSelectedFolder(FString::Join(FolderPathsSelected, TEXT("\n")))
 	];
 
 	ConstructedDockTab->SetOnTabClosed(
@@ -277,27 +367,17 @@ TSharedRef<SDockTab> FSuperManagerModule::OnSpawnAdvancedDeleteTab(const FSpawnT
 	return ConstructedDockTab.ToSharedRef();
 }
 
-TArray<TSharedPtr<FAssetData>> FSuperManagerModule::GetAllAssetDataUnderSelectedFolder()
+TSharedRef<FAsyncAssetDataGatherer, ESPMode::ThreadSafe> FSuperManagerModule::StartGatheringAssetDataUnderFolders(const TArray<FString>& FolderPaths)
 {
-	TArray<TSharedPtr<FAssetData>> AvailableAssetData;
-
-	TArray<FString> AssetsPathNames = UEditorAssetLibrary::ListAssets(FolderPathsSelected[0]);
+	TArray<FString> RootFolderPaths;
+	CollapseNestedFolderPaths(FolderPaths, RootFolderPaths);
 
-	for(const FString& AssetPathName : AssetsPathNames)
-	{
-		if(AssetPathName.Contains(TEXT("Developers")) || AssetPathName.Contains(TEXT("Collections")))
-		{
-			continue;
-		}
-		
-		if(!UEditorAssetLibrary::DoesAssetExist(AssetPathName)) continue;
+	TSharedRef<FAsyncAssetDataGatherer, ESPMode::ThreadSafe> AssetDataGatherer =
+		MakeShared<FAsyncAssetDataGatherer, ESPMode::ThreadSafe>(RootFolderPaths, AssetPathFilter);
 
-		const FAssetData Data = UEditorAssetLibrary::FindAssetData(AssetPathName);
+	AssetDataGatherer->Start();
 
-		AvailableAssetData.Add(MakeShared<FAssetData>(Data));
-	}
-	
-	return AvailableAssetData;
+	return AssetDataGatherer;
 }
 
 void FSuperManagerModule::OnAdvancedDeleteTabClosed(TSharedRef<SDockTab> TabToClose)
@@ -595,75 +675,1010 @@ bool FSuperManagerModule::DeleteSingleAssetForAssetList(const FAssetData& AssetD
 	return false;
 }
 
-bool FSuperManagerModule::DeleteMultipleAssetsForAssetsList(const TArray<FAssetData>& AssetsToDelete)
+bool FSuperManagerModule::DeleteMultipleAssetsForAssetsList(const TArray<FAssetData>& AssetsToDelete,
+	TSet<FSoftObjectPath>& OutDeletedAssetPaths)
 {
-	if(ObjectTools::DeleteAssets(AssetsToDelete) > 0)
+	OutDeletedAssetPaths.Reset();
+
+	//Referenced assets still go through the editor's delete dialog, which lists the references and offers force delete
+	const FAssetReferenceGraph& ReferenceGraph = GetAssetReferenceGraph();
+
+	TArray<FAssetData> UnreferencedAssetsToDelete;
+	TArray<FAssetData> ReferencedAssetsToDelete;
+
+	for(const FAssetData& AssetToDelete : AssetsToDelete)
 	{
-		return true;
+		if(ReferenceGraph.IsAssetUnreferenced(AssetToDelete))
+		{
+			UnreferencedAssetsToDelete.Add(AssetToDelete);
+		}
+		else
+		{
+			ReferencedAssetsToDelete.Add(AssetToDelete);
+		}
 	}
-	return false;
+
+	if(UnreferencedAssetsToDelete.Num() > 0)
+	{
+		EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
+			TEXT("Delete ") + FString::FromInt(UnreferencedAssetsToDelete.Num()) + TEXT(" unreferenced assets?"));
+
+		if(ConfirmResult == EAppReturnType::No) return false;
+
+		if(!DeleteAssetsInChunks(UnreferencedAssetsToDelete, OutDeletedAssetPaths))
+		{
+			DebugHeader::ShowNotifyInfo(TEXT("Deletion cancelled after ") + FString::FromInt(OutDeletedAssetPaths.Num()) + TEXT(" assets"));
+			return OutDeletedAssetPaths.Num() > 0;
+		}
+	}
+
+	if(ReferencedAssetsToDelete.Num() > 0)
+	{
+		ObjectTools::DeleteAssets(ReferencedAssetsToDelete);
+
+		GatherDeletedAssetPaths(ReferencedAssetsToDelete, OutDeletedAssetPaths);
+	}
+
+	return OutDeletedAssetPaths.Num() > 0;
 }
 
-void FSuperManagerModule::ListUnusedAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter,
-	TArray<TSharedPtr<FAssetData>>& OutUnusedAssetsData)
+bool FSuperManagerModule::DeleteAssetsInChunks(const TArray<FAssetData>& AssetsToDelete, TSet<FSoftObjectPath>& OutDeletedAssetPaths)
 {
-	OutUnusedAssetsData.Empty();
-	
-	for(const TSharedPtr<FAssetData>& DataSharedPtr : AssetDataToFilter)
+	//Bounded chunks keep the number of loaded assets low, garbage collection in between releases them
+	const int32 ChunkSize = 256;
+	const int32 NumChunks = FMath::DivideAndRoundUp(AssetsToDelete.Num(), ChunkSize);
+
+	FScopedSlowTask DeleteTask(NumChunks, FText::FromString(TEXT("Deleting assets...")));
+	DeleteTask.MakeDialog(true);
+
+	for(int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		if(DeleteTask.ShouldCancel()) return false;
+
+		DeleteTask.EnterProgressFrame(1.f, FText::FromString(FString::Printf(TEXT("Deleting assets... %d of %d"),
+			ChunkIndex * ChunkSize, AssetsToDelete.Num())));
+
+		const int32 ChunkStart = ChunkIndex * ChunkSize;
+		const TArray<FAssetData> ChunkAssetsToDelete(AssetsToDelete.GetData() + ChunkStart,
+			FMath::Min(ChunkSize, AssetsToDelete.Num() - ChunkStart));
+
+		ObjectTools::DeleteAssets(ChunkAssetsToDelete, false);
+
+		GatherDeletedAssetPaths(ChunkAssetsToDelete, OutDeletedAssetPaths);
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	return true;
+}
+
+//Writes names and object references as strings, with the asset's own name, path and package name replaced by placeholders,
+//so two assets serialize to the same bytes exactly when they are identical apart from where they live
+class FDuplicateComparisonWriter : public FMemoryWriter
+{
+public:
+	FDuplicateComparisonWriter(TArray<uint8>& InBytes, const UObject& InAsset)
+		: FMemoryWriter(InBytes, true)
+		, AssetName(InAsset.GetName())
+		, AssetPathName(InAsset.GetPathName())
+		, PackageName(InAsset.GetPackage()->GetName())
+	{
+	}
+
+	virtual FString GetArchiveName() const override { return TEXT("FDuplicateComparisonWriter"); }
+
+	virtual FArchive& operator<<(FName& Name) override
 	{
-		TArray<FString> AssetReferencers = UEditorAssetLibrary::FindPackageReferencersForAsset(DataSharedPtr->ObjectPath.ToString());
+		FString NameString = Name.ToString();
 
-		if(AssetReferencers.Num() == 0)
+		if(NameString.Equals(AssetName, ESearchCase::CaseSensitive))
+		{
+			NameString = TEXT("\x01");
+		}
+		else if(NameString.Equals(PackageName, ESearchCase::CaseSensitive))
 		{
-			OutUnusedAssetsData.Add(DataSharedPtr);
+			NameString = TEXT("\x02");
 		}
+
+		*this << NameString;
+		return *this;
 	}
-}
 
-void FSuperManagerModule::ListSameNameAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter,
-	TArray<TSharedPtr<FAssetData>>& OutSameNameAssetsData)
+	virtual FArchive& operator<<(UObject*& Object) override
+	{
+		FString PathString = Object ? GetComparablePath(*Object) : FString();
+
+		*this << PathString;
+		return *this;
+	}
+
+	//Objects of the asset's own package are written relative to the asset or the package
+	FString GetComparablePath(const UObject& Object) const
+	{
+		const FString PathName = Object.GetPathName();
+
+		if(IsPathUnder(PathName, AssetPathName)) return TEXT("\x01") + PathName.RightChop(AssetPathName.Len());
+		if(IsPathUnder(PathName, PackageName)) return TEXT("\x02") + PathName.RightChop(PackageName.Len());
+
+		return PathName;
+	}
+
+private:
+	static bool IsPathUnder(const FString& PathName, const FString& OuterPathName)
+	{
+		if(!PathName.StartsWith(OuterPathName, ESearchCase::CaseSensitive)) return false;
+
+		return PathName.Len() == OuterPathName.Len() || PathName[OuterPathName.Len()] == TEXT('.') || PathName[OuterPathName.Len()] == TEXT(':');
+	}
+
+	FString AssetName;
+	FString AssetPathName;
+	FString PackageName;
+};
+
+//Serializes the asset and every other object in its package in path order. Package metadata is left out, its map order
+//follows how the package was edited rather than what it holds.
+static void SerializeForDuplicateComparison(UObject& Asset, TArray<uint8>& OutBytes)
 {
-	OutSameNameAssetsData.Empty();
+	OutBytes.Reset();
 
-	TMultiMap<FString,TSharedPtr<FAssetData>> AssetsInfoMultiMap;
+	FDuplicateComparisonWriter ComparisonWriter(OutBytes, Asset);
 
-	for(const TSharedPtr<FAssetData>& DataSharedPtr : AssetDataToFilter)
+	TArray<UObject*> PackageObjects;
+	GetObjectsWithPackage(Asset.GetPackage(), PackageObjects, true, RF_ClassDefaultObject | RF_Transient);
+
+	TArray<TPair<FString, UObject*>> SortedPackageObjects;
+
+	for(UObject* PackageObject : PackageObjects)
+	{
+		if(PackageObject->IsA<UMetaData>()) continue;
+
+		SortedPackageObjects.Emplace(ComparisonWriter.GetComparablePath(*PackageObject), PackageObject);
+	}
+
+	Algo::SortBy(SortedPackageObjects, [](const TPair<FString, UObject*>& SortedPackageObject) { return SortedPackageObject.Key; });
+
+	for(TPair<FString, UObject*>& SortedPackageObject : SortedPackageObjects)
 	{
-		AssetsInfoMultiMap.Emplace(DataSharedPtr->AssetName.ToString(), DataSharedPtr);
+		FString ClassPathName = SortedPackageObject.Value->GetClass()->GetPathName();
+
+		ComparisonWriter << SortedPackageObject.Key << ClassPathName;
+		SortedPackageObject.Value->Serialize(ComparisonWriter);
 	}
+}
+
+bool FSuperManagerModule::ConsolidateDuplicatesForAssetList(const TArray<TArray<FAssetData>>& DuplicateGroups,
+	TSet<FSoftObjectPath>& OutConsolidatedAssetPaths)
+{
+	OutConsolidatedAssetPaths.Reset();
+
+	//Packages dirty before hold the user's own unsaved edits, only the referencers fixed up below are offered for saving
+	TArray<UPackage*> PreviouslyDirtyPackages;
+	FEditorFileUtils::GetDirtyContentPackages(PreviouslyDirtyPackages);
+	const TSet<UPackage*> PreviouslyDirtyPackageSet(PreviouslyDirtyPackages);
+
+	FScopedSlowTask ConsolidateTask(DuplicateGroups.Num() + 2, FText::FromString(TEXT("Consolidating duplicates...")));
+	ConsolidateTask.MakeDialog();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> ConsolidatedAssets;
+
+	//A retargeted referencer left unsaved would still point at the removed duplicates on disk, dirty before or not
+	TSet<FName> ReferencerPackageNames;
 
-	for(const TSharedPtr<FAssetData>& DataSharedPtr : AssetDataToFilter)
+	//Redirectors are kept alive until the single fixup pass, garbage collected during consolidation or not
+	TArray<TStrongObjectPtr<UObjectRedirector>> ConsolidatedRedirectors;
+
+	//The engine consolidates into one object per call, so each group is one call with all of its duplicates in it
+	for(const TArray<FAssetData>& DuplicateGroup : DuplicateGroups)
 	{
-		TArray<TSharedPtr<FAssetData>> OutAssetsData;
-		AssetsInfoMultiMap.MultiFind(DataSharedPtr->AssetName.ToString(), OutAssetsData);
+		ConsolidateTask.EnterProgressFrame(1.f);
+
+		if(DuplicateGroup.Num() < 2) continue;
+
+		UObject* KeptObject = DuplicateGroup[0].GetAsset();
+
+		if(!KeptObject) continue;
+
+		TArray<uint8> KeptObjectBytes;
+		SerializeForDuplicateComparison(*KeptObject, KeptObjectBytes);
+
+		TArray<uint8> DuplicateObjectBytes;
+
+		TArray<UObject*> ObjectsToConsolidate;
+		TArray<FAssetData> AssetsToConsolidate;
+
+		for(int32 AssetIndex = 1; AssetIndex < DuplicateGroup.Num(); ++AssetIndex)
+		{
+			UObject* DuplicateObject = DuplicateGroup[AssetIndex].GetAsset();
+
+			//References can only be retargeted to an object of the same class, and neither hash tells classes apart
+			if(!DuplicateObject || DuplicateObject->GetClass() != KeptObject->GetClass()) continue;
+
+			//Hashes only nominate duplicates and distinct assets can share one, so only exact copies of the kept asset are removed
+			SerializeForDuplicateComparison(*DuplicateObject, DuplicateObjectBytes);
+
+			if(DuplicateObjectBytes != KeptObjectBytes) continue;
+
+			ObjectsToConsolidate.Add(DuplicateObject);
+			AssetsToConsolidate.Add(DuplicateGroup[AssetIndex]);
+		}
+
+		if(ObjectsToConsolidate.Num() == 0) continue;
+
+		//Gathered before consolidating, while the registry still lists every referencer of the duplicates
+		for(const FAssetData& AssetToConsolidate : AssetsToConsolidate)
+		{
+			TArray<FName> Referencers;
+			AssetRegistry.GetReferencers(AssetToConsolidate.PackageName, Referencers);
+
+			ReferencerPackageNames.Append(Referencers);
+		}
 
-		if(OutAssetsData.Num() <= 1) continue;
+		ObjectTools::ConsolidateObjects(KeptObject, ObjectsToConsolidate, false);
 
-		for(const TSharedPtr<FAssetData>& SameNameData : OutAssetsData)
+		for(const FAssetData& ConsolidatedAsset : AssetsToConsolidate)
 		{
-			if(SameNameData.IsValid())
+			if(UObjectRedirector* Redirector = FindObject<UObjectRedirector>(nullptr, *ConsolidatedAsset.GetObjectPathString()))
 			{
-				OutSameNameAssetsData.AddUnique(SameNameData);
+				ConsolidatedRedirectors.Emplace(Redirector);
 			}
 		}
+
+		ConsolidatedAssets.Append(AssetsToConsolidate);
+	}
+
+	if(ConsolidatedAssets.Num() == 0) return false;
+
+	//Every referencer on disk is loaded, retargeted and saved once for all groups together
+	ConsolidateTask.EnterProgressFrame(1.f, FText::FromString(TEXT("Fixing up redirectors...")));
+
+	TArray<UObjectRedirector*> RedirectorsToFix;
+
+	for(const TStrongObjectPtr<UObjectRedirector>& ConsolidatedRedirector : ConsolidatedRedirectors)
+	{
+		RedirectorsToFix.Add(ConsolidatedRedirector.Get());
+	}
+
+	if(RedirectorsToFix.Num() > 0)
+	{
+		FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+		AssetToolsModule.Get().FixupReferencers(RedirectorsToFix, false);
+	}
+
+	ConsolidatedRedirectors.Empty();
+
+	ConsolidateTask.EnterProgressFrame(1.f, FText::FromString(TEXT("Saving packages...")));
+
+	TArray<UPackage*> DirtyPackages;
+	FEditorFileUtils::GetDirtyContentPackages(DirtyPackages);
+
+	TArray<UPackage*> PackagesToSave;
+	TArray<UPackage*> EditedReferencerPackages;
+
+	for(UPackage* DirtyPackage : DirtyPackages)
+	{
+		if(!PreviouslyDirtyPackageSet.Contains(DirtyPackage))
+		{
+			PackagesToSave.Add(DirtyPackage);
+		}
+		else if(ReferencerPackageNames.Contains(DirtyPackage->GetFName()))
+		{
+			EditedReferencerPackages.Add(DirtyPackage);
+		}
 	}
+
+	if(PackagesToSave.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	}
+
+	//Saving these would also write the user's own pending edits, so the user picks which of them to save
+	if(EditedReferencerPackages.Num() > 0)
+	{
+		FEditorFileUtils::PromptForCheckoutAndSave(EditedReferencerPackages, true, true);
+	}
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	GatherDeletedAssetPaths(ConsolidatedAssets, OutConsolidatedAssetPaths);
+
+	return OutConsolidatedAssetPaths.Num() > 0;
 }
 
-void FSuperManagerModule::SyncSBToClickedAssetForAssetList(const FString& AssetPathToSync)
+void FSuperManagerModule::GatherDeletedAssetPaths(const TArray<FAssetData>& AssetsToDelete, TSet<FSoftObjectPath>& OutDeletedAssetPaths)
 {
-	TArray<FString> AssetsPathToSync;
-	AssetsPathToSync.Add(AssetPathToSync);
-	
-	UEditorAssetLibrary::SyncBrowserToObjects(AssetsPathToSync);
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	//The registry drops deleted assets right away, whatever it still knows about was kept
+	for(const FAssetData& AssetToDelete : AssetsToDelete)
+	{
+		const FSoftObjectPath AssetPath = AssetToDelete.GetSoftObjectPath();
+
+		if(!AssetRegistry.GetAssetByObjectPath(AssetPath).IsValid())
+		{
+			OutDeletedAssetPaths.Add(AssetPath);
+		}
+	}
 }
 
-#pragma endregion
+void FSuperManagerModule::MarkReachablePackages(TBitArray<>& OutReachablePackages)
+{
+	const FAssetReferenceGraph& ReferenceGraph = GetAssetReferenceGraph();
 
+	TArray<int32> RootPackageIndices;
+	GatherReachabilityRootPackages(ReferenceGraph, RootPackageIndices);
 
-void FSuperManagerModule::ShutdownModule()
+	ReferenceGraph.MarkReachablePackages(RootPackageIndices, OutReachablePackages);
+}
+
+//Items sharing their key with another item, in input order, items without a key share it with nothing
+template<typename KeyType, typename GetKeyFuncType>
+static void ListAssetsSharingKey(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToFilter, GetKeyFuncType GetKey,
+	TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutSharingItems)
 {
-	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
-	// we call this function before unloading the module.
+	OutSharingItems.Empty();
+
+	TMap<KeyType, int32> KeyCounts;
+	KeyCounts.Reserve(ItemsToFilter.Num());
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& Item : ItemsToFilter)
+	{
+		if(const TOptional<KeyType> Key = GetKey(*Item))
+		{
+			++KeyCounts.FindOrAdd(*Key);
+		}
+	}
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& Item : ItemsToFilter)
+	{
+		const TOptional<KeyType> Key = GetKey(*Item);
+
+		if(Key && KeyCounts.FindChecked(*Key) > 1)
+		{
+			OutSharingItems.Add(Item);
+		}
+	}
+}
+
+//Groups in order of their first item in one pass, items without a key get a group of their own
+template<typename KeyType, typename GetKeyFuncType>
+static void GroupAssetsByKey(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToGroup, GetKeyFuncType GetKey,
+	TArray<TArray<TSharedPtr<FAdvancedDeleteListItem>>>& OutGroups)
+{
+	OutGroups.Empty();
+
+	TMap<KeyType, int32> GroupIndices;
+	GroupIndices.Reserve(ItemsToGroup.Num());
+
+	for(const TSharedPtr<FAdvancedDeleteListItem>& Item : ItemsToGroup)
+	{
+		const TOptional<KeyType> Key = GetKey(*Item);
+
+		if(!Key)
+		{
+			OutGroups.AddDefaulted_GetRef().Add(Item);
+			continue;
+		}
+
+		int32& GroupIndex = GroupIndices.FindOrAdd(*Key, INDEX_NONE);
+
+		if(GroupIndex == INDEX_NONE)
+		{
+			GroupIndex = OutGroups.AddDefaulted();
+		}
+
+		OutGroups[GroupIndex].Add(Item);
+	}
+}
+
+//Names are compared as FNames, no string is built for any asset
+static TOptional<FName> GetAssetNameKey(const FAdvancedDeleteListItem& Item)
+{
+	return Item.AssetData.AssetName;
+}
+
+static TOptional<FAssetContentHash> GetContentHashKey(const FAdvancedDeleteListItem& Item)
+{
+	return Item.ContentHash.IsValid() ? TOptional<FAssetContentHash>(Item.ContentHash) : TOptional<FAssetContentHash>();
+}
+
+static TOptional<uint64> GetGeometryHashKey(const FAdvancedDeleteListItem& Item)
+{
+	return Item.bGeometryHashed ? TOptional<uint64>(Item.GeometryHash) : TOptional<uint64>();
+}
+
+void FSuperManagerModule::ListSameNameAssetsForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToFilter,
+	TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutSameNameItems)
+{
+	ListAssetsSharingKey<FName>(ItemsToFilter, &GetAssetNameKey, OutSameNameItems);
+}
+
+void FSuperManagerModule::GroupSameNameAssetsForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToGroup,
+	TArray<TArray<TSharedPtr<FAdvancedDeleteListItem>>>& OutSameNameGroups)
+{
+	GroupAssetsByKey<FName>(ItemsToGroup, &GetAssetNameKey, OutSameNameGroups);
+}
+
+void FSuperManagerModule::ListSameContentAssetsForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToFilter,
+	TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutSameContentItems)
+{
+	ListAssetsSharingKey<FAssetContentHash>(ItemsToFilter, &GetContentHashKey, OutSameContentItems);
+}
+
+void FSuperManagerModule::GroupSameContentAssetsForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToGroup,
+	TArray<TArray<TSharedPtr<FAdvancedDeleteListItem>>>& OutSameContentGroups)
+{
+	GroupAssetsByKey<FAssetContentHash>(ItemsToGroup, &GetContentHashKey, OutSameContentGroups);
+}
+
+void FSuperManagerModule::ListSameGeometryAssetsForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToFilter,
+	TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutSameGeometryItems)
+{
+	ListAssetsSharingKey<uint64>(ItemsToFilter, &GetGeometryHashKey, OutSameGeometryItems);
+}
+
+void FSuperManagerModule::GroupSameGeometryAssetsForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToGroup,
+	TArray<TArray<TSharedPtr<FAdvancedDeleteListItem>>>& OutSameGeometryGroups)
+{
+	GroupAssetsByKey<uint64>(ItemsToGroup, &GetGeometryHashKey, OutSameGeometryGroups);
+}
+
+//Cluster of every item by the position of its cluster's first item, INDEX_NONE for items without a perceptual hash.
+//Textures join a cluster when their hash is within the distance of any texture in it, so clusters can chain.
+static void ClusterByPerceptualHash(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToCluster, int32 MaxHashDistance,
+	TArray<int32>& OutClusterPositions)
+{
+	OutClusterPositions.Init(INDEX_NONE, ItemsToCluster.Num());
+
+	//Hashes are packed next to each other, so the pair scan below streams through one array of plain words
+	TArray<uint64> PackedHashes;
+	TArray<int32> HashedPositions;
+
+	for(int32 ItemPosition = 0; ItemPosition < ItemsToCluster.Num(); ++ItemPosition)
+	{
+		if(!ItemsToCluster[ItemPosition]->bPerceptualHashed) continue;
+
+		PackedHashes.Add(ItemsToCluster[ItemPosition]->PerceptualHash);
+		HashedPositions.Add(ItemPosition);
+	}
+
+	const int32 NumHashes = PackedHashes.Num();
+
+	//Every pair is compared once, rows are independent and spread over workers
+	TArray<TArray<int32>> SimilarHashIndices;
+	SimilarHashIndices.SetNum(NumHashes);
+
+	ParallelFor(NumHashes, [&](int32 HashIndex)
+	{
+		const uint64 Hash = PackedHashes[HashIndex];
+		const uint64* OtherHashes = PackedHashes.GetData();
+
+		for(int32 OtherHashIndex = HashIndex + 1; OtherHashIndex < NumHashes; ++OtherHashIndex)
+		{
+			if(static_cast<int32>(FMath::CountBits(Hash ^ OtherHashes[OtherHashIndex])) <= MaxHashDistance)
+			{
+				SimilarHashIndices[HashIndex].Add(OtherHashIndex);
+			}
+		}
+	});
+
+	//Union find over the similar pairs, the lower index always becomes the parent so a cluster is rooted at its first item
+	TArray<int32> ParentIndices;
+	ParentIndices.SetNumUninitialized(NumHashes);
+
+	for(int32 HashIndex = 0; HashIndex < NumHashes; ++HashIndex)
+	{
+		ParentIndices[HashIndex] = HashIndex;
+	}
+
+	auto FindRootIndex = [&ParentIndices](int32 HashIndex)
+	{
+		while(ParentIndices[HashIndex] != HashIndex)
+		{
+			ParentIndices[HashIndex] = ParentIndices[ParentIndices[HashIndex]];
+			HashIndex = ParentIndices[HashIndex];
+		}
+
+		return HashIndex;
+	};
+
+	for(int32 HashIndex = 0; HashIndex < NumHashes; ++HashIndex)
+	{
+		for(const int32 OtherHashIndex : SimilarHashIndices[HashIndex])
+		{
+			const int32 RootIndex = FindRootIndex(HashIndex);
+			const int32 OtherRootIndex = FindRootIndex(OtherHashIndex);
+
+			if(RootIndex != OtherRootIndex)
+			{
+				ParentIndices[FMath::Max(RootIndex, OtherRootIndex)] = FMath::Min(RootIndex, OtherRootIndex);
+			}
+		}
+	}
+
+	for(int32 HashIndex = 0; HashIndex < NumHashes; ++HashIndex)
+	{
+		OutClusterPositions[HashedPositions[HashIndex]] = HashedPositions[FindRootIndex(HashIndex)];
+	}
+}
+
+void FSuperManagerModule::ClusterSimilarTexturesForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToCluster)
+{
+	TArray<int32> ClusterPositions;
+	ClusterByPerceptualHash(ItemsToCluster, GetDefault<USuperManagerSettings>()->SimilarTextureMaxHashDistance, ClusterPositions);
+
+	for(int32 ItemPosition = 0; ItemPosition < ItemsToCluster.Num(); ++ItemPosition)
+	{
+		const int32 ClusterPosition = ClusterPositions[ItemPosition];
+
+		ItemsToCluster[ItemPosition]->SimilarTextureClusterId =
+			ClusterPosition != INDEX_NONE ? ItemsToCluster[ClusterPosition]->ItemIndex : INDEX_NONE;
+	}
+}
+
+static TOptional<int32> GetSimilarTextureClusterKey(const FAdvancedDeleteListItem& Item)
+{
+	return Item.SimilarTextureClusterId != INDEX_NONE ? TOptional<int32>(Item.SimilarTextureClusterId) : TOptional<int32>();
+}
+
+void FSuperManagerModule::ListSimilarTexturesForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToFilter,
+	TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutSimilarItems)
+{
+	ListAssetsSharingKey<int32>(ItemsToFilter, &GetSimilarTextureClusterKey, OutSimilarItems);
+}
+
+void FSuperManagerModule::GroupSimilarTexturesForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToGroup,
+	TArray<TArray<TSharedPtr<FAdvancedDeleteListItem>>>& OutSimilarGroups)
+{
+	GroupAssetsByKey<int32>(ItemsToGroup, &GetSimilarTextureClusterKey, OutSimilarGroups);
+}
+
+FAssetContentHashCache& FSuperManagerModule::GetAssetContentHashCache()
+{
+	if(!bAssetContentHashCacheLoaded)
+	{
+		AssetContentHashCache.Load(FAssetContentHashCache::GetDefaultCacheFilePath());
+		bAssetContentHashCacheLoaded = true;
+
+		PruneAssetContentHashCache();
+	}
+
+	return AssetContentHashCache;
+}
+
+void FSuperManagerModule::SaveAssetContentHashCache()
+{
+	if(!bAssetContentHashCacheLoaded) return;
+
+	PruneAssetContentHashCache();
+
+	if(!AssetContentHashCache.IsDirty()) return;
+
+	AssetContentHashCache.Save(FAssetContentHashCache::GetDefaultCacheFilePath());
+}
+
+void FSuperManagerModule::PruneAssetContentHashCache()
+{
+	//Without the graph every package would look missing
+	if(!AssetReferenceGraph.IsBuilt()) return;
+
+	AssetContentHashCache.RemoveMissingPackages([this](FName PackageName) { return DoesPackageExist(PackageName); });
+}
+
+FAssetSourceHashCache& FSuperManagerModule::GetPerceptualHashCache()
+{
+	if(!bPerceptualHashCacheLoaded)
+	{
+		PerceptualHashCache.Load(FAssetSourceHashCache::GetCacheFilePath(TEXT("PerceptualHashCache.bin")));
+		bPerceptualHashCacheLoaded = true;
+
+		PruneSourceHashCache(PerceptualHashCache);
+	}
+
+	return PerceptualHashCache;
+}
+
+void FSuperManagerModule::SavePerceptualHashCache()
+{
+	if(!bPerceptualHashCacheLoaded) return;
+
+	PruneSourceHashCache(PerceptualHashCache);
+
+	if(!PerceptualHashCache.IsDirty()) return;
+
+	PerceptualHashCache.Save(FAssetSourceHashCache::GetCacheFilePath(TEXT("PerceptualHashCache.bin")));
+}
+
+FAssetSourceHashCache& FSuperManagerModule::GetGeometryHashCache()
+{
+	if(!bGeometryHashCacheLoaded)
+	{
+		GeometryHashCache.Load(FAssetSourceHashCache::GetCacheFilePath(TEXT("GeometryHashCache.bin")));
+		bGeometryHashCacheLoaded = true;
+
+		PruneSourceHashCache(GeometryHashCache);
+	}
+
+	return GeometryHashCache;
+}
+
+void FSuperManagerModule::SaveGeometryHashCache()
+{
+	if(!bGeometryHashCacheLoaded) return;
+
+	PruneSourceHashCache(GeometryHashCache);
+
+	if(!GeometryHashCache.IsDirty()) return;
+
+	GeometryHashCache.Save(FAssetSourceHashCache::GetCacheFilePath(TEXT("GeometryHashCache.bin")));
+}
+
+void FSuperManagerModule::PruneSourceHashCache(FAssetSourceHashCache& SourceHashCache)
+{
+	if(!AssetReferenceGraph.IsBuilt()) return;
+
+	SourceHashCache.RemoveMissingPackages([this](FName PackageName) { return DoesPackageExist(PackageName); });
+}
+
+bool FSuperManagerModule::DoesPackageExist(FName PackageName) const
+{
+	const int32 PackageIndex = AssetReferenceGraph.FindPackageIndex(PackageName);
+
+	return PackageIndex != INDEX_NONE && AssetReferenceGraph.DoesPackageExist(PackageIndex);
+}
+
+const FAssetReferenceGraph& FSuperManagerModule::GetAssetReferenceGraph()
+{
+	if(!AssetReferenceGraph.IsBuilt())
+	{
+		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+		BuildAssetReferenceGraph(AssetRegistryModule.Get());
+	}
+
+	return AssetReferenceGraph;
+}
+
+void FSuperManagerModule::GatherAssetDataUnderFolders(const TArray<FString>& FolderPaths, TArray<FAssetData>& OutAssetsData)
+{
+	TArray<FString> RootFolderPaths;
+	CollapseNestedFolderPaths(FolderPaths, RootFolderPaths);
+
+	QueryAssetDataUnderFolders(RootFolderPaths, OutAssetsData);
+
+	OutAssetsData.RemoveAllSwap([this](const FAssetData& AssetData)
+	{
+		return AssetData.IsRedirector() || AssetPathFilter.IsPathExcluded(AssetData.PackagePath);
+	}, EAllowShrinking::No);
+}
+
+void FSuperManagerModule::QueryAssetDataUnderFolders(const TArray<FString>& RootFolderPaths, TArray<FAssetData>& OutAssetsData)
+{
+	OutAssetsData.Empty();
+
+	if(RootFolderPaths.Num() == 0) return;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+
+	for(const FString& RootFolderPath : RootFolderPaths)
+	{
+		Filter.PackagePaths.Emplace(RootFolderPath);
+	}
+
+	AssetRegistry.GetAssets(Filter, OutAssetsData);
+}
+
+void FSuperManagerModule::CollapseNestedFolderPaths(const TArray<FString>& FolderPaths, TArray<FString>& OutRootFolderPaths)
+{
+	OutRootFolderPaths.Empty();
+
+	TArray<FString> SortedFolderPaths;
+	SortedFolderPaths.Reserve(FolderPaths.Num());
+
+	for(const FString& FolderPath : FolderPaths)
+	{
+		FString NormalizedFolderPath = FolderPath;
+		NormalizedFolderPath.RemoveFromEnd(TEXT("/"));
+
+		if(!NormalizedFolderPath.IsEmpty()) SortedFolderPaths.Add(MoveTemp(NormalizedFolderPath));
+	}
+
+	//Shorter paths first, so every folder that could contain another one is already a root when that one is checked
+	SortedFolderPaths.Sort([](const FString& A, const FString& B)
+	{
+		return A.Len() < B.Len();
+	});
+
+	TSet<FString> RootFolderPathSet;
+
+	for(const FString& FolderPath : SortedFolderPaths)
+	{
+		bool bIsCovered = RootFolderPathSet.Contains(FolderPath);
+
+		for(int32 CharIndex = FolderPath.Len() - 1; CharIndex > 0 && !bIsCovered; --CharIndex)
+		{
+			if(FolderPath[CharIndex] == TEXT('/'))
+			{
+				bIsCovered = RootFolderPathSet.Contains(FolderPath.Left(CharIndex));
+			}
+		}
+
+		if(bIsCovered) continue;
+
+		RootFolderPathSet.Add(FolderPath);
+		OutRootFolderPaths.Add(FolderPath);
+	}
+}
+
+void FSuperManagerModule::SyncSBToClickedAssetForAssetList(const FString& AssetPathToSync)
+{
+	TArray<FString> AssetsPathToSync;
+	AssetsPathToSync.Add(AssetPathToSync);
+	
+	UEditorAssetLibrary::SyncBrowserToObjects(AssetsPathToSync);
+}
+
+#pragma endregion
+
+#pragma region AssetPathFilter
+
+void FSuperManagerModule::InitAssetPathFilter()
+{
+	USuperManagerSettings* SuperManagerSettings = GetMutableDefault<USuperManagerSettings>();
+
+	AssetPathFilter.Compile(SuperManagerSettings->PathRules);
+
+	SuperManagerSettings->OnSettingChanged().AddRaw(this, &FSuperManagerModule::OnSuperManagerSettingsChanged);
+}
+
+void FSuperManagerModule::ShutdownAssetPathFilter()
+{
+	if(UObjectInitialized())
+	{
+		GetMutableDefault<USuperManagerSettings>()->OnSettingChanged().RemoveAll(this);
+	}
+}
+
+void FSuperManagerModule::OnSuperManagerSettingsChanged(UObject* ChangedSettings, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	AssetPathFilter.Compile(GetDefault<USuperManagerSettings>()->PathRules);
+}
+
+#pragma endregion
+
+#pragma region AssetReferenceTracking
+
+void FSuperManagerModule::InitAssetReferenceTracking()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	if(AssetRegistry.IsLoadingAssets())
+	{
+		AssetRegistry.OnFilesLoaded().AddRaw(this, &FSuperManagerModule::OnAssetRegistryFilesLoaded);
+	}
+	else if(!IsRunningCommandlet())
+	{
+		BuildAssetReferenceGraph(AssetRegistry);
+	}
+
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FSuperManagerModule::OnAssetAddedToRegistry);
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FSuperManagerModule::OnAssetRemovedFromRegistry);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FSuperManagerModule::OnAssetRenamedInRegistry);
+	AssetRegistry.OnAssetUpdated().AddRaw(this, &FSuperManagerModule::OnAssetUpdatedInRegistry);
+}
+
+void FSuperManagerModule::BuildAssetReferenceGraph(IAssetRegistry& AssetRegistry)
+{
+	const FString ScanCacheFilePath = FAssetScanCache::GetDefaultCacheFilePath();
+
+	if(!bAssetScanCacheLoaded)
+	{
+		AssetScanCache.Load(ScanCacheFilePath);
+		bAssetScanCacheLoaded = true;
+	}
+
+	AssetReferenceGraph.Build(AssetRegistry, &AssetScanCache);
+
+	if(AssetScanCache.IsDirty()) AssetScanCache.Save(ScanCacheFilePath);
+}
+
+void FSuperManagerModule::ShutdownAssetReferenceTracking()
+{
+	if(FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+
+		AssetRegistry.OnFilesLoaded().RemoveAll(this);
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+		AssetRegistry.OnAssetUpdated().RemoveAll(this);
+	}
+
+	//Packages re-gathered since the last build are kept for the next session
+	if(bAssetScanCacheLoaded && AssetScanCache.IsDirty())
+	{
+		AssetScanCache.Save(FAssetScanCache::GetDefaultCacheFilePath());
+	}
+
+	AssetReferenceGraph.Reset();
+}
+
+void FSuperManagerModule::GatherReachabilityRootPackages(const FAssetReferenceGraph& ReferenceGraph, TArray<int32>& OutRootPackageIndices)
+{
+	OutRootPackageIndices.Empty();
+
+	const USuperManagerSettings* SuperManagerSettings = GetDefault<USuperManagerSettings>();
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	auto AddRootPackage = [&ReferenceGraph, &OutRootPackageIndices](FName PackageName)
+	{
+		const int32 PackageIndex = ReferenceGraph.FindPackageIndex(PackageName);
+
+		if(PackageIndex != INDEX_NONE) OutRootPackageIndices.Add(PackageIndex);
+	};
+
+	if(SuperManagerSettings->bMapsAreRoots)
+	{
+		TArray<FAssetData> MapsData;
+		AssetRegistry.GetAssetsByClass(UWorld::StaticClass()->GetClassPathName(), MapsData);
+
+		for(const FAssetData& MapData : MapsData)
+		{
+			AddRootPackage(MapData.PackageName);
+		}
+	}
+
+	if(SuperManagerSettings->bPrimaryAssetsAreRoots && UAssetManager::IsInitialized())
+	{
+		UAssetManager& AssetManager = UAssetManager::Get();
+
+		TArray<FPrimaryAssetTypeInfo> PrimaryAssetTypeInfos;
+		AssetManager.GetPrimaryAssetTypeInfoList(PrimaryAssetTypeInfos);
+
+		for(const FPrimaryAssetTypeInfo& PrimaryAssetTypeInfo : PrimaryAssetTypeInfos)
+		{
+			TArray<FPrimaryAssetId> PrimaryAssetIds;
+			AssetManager.GetPrimaryAssetIdList(PrimaryAssetTypeInfo.PrimaryAssetType, PrimaryAssetIds);
+
+			for(const FPrimaryAssetId& PrimaryAssetId : PrimaryAssetIds)
+			{
+				const FSoftObjectPath PrimaryAssetPath = AssetManager.GetPrimaryAssetPath(PrimaryAssetId);
+
+				if(PrimaryAssetPath.IsValid()) AddRootPackage(PrimaryAssetPath.GetLongPackageFName());
+			}
+		}
+	}
+
+	TArray<FString> RootDirectories;
+
+	for(const FDirectoryPath& AdditionalRootDirectory : SuperManagerSettings->AdditionalRootDirectories)
+	{
+		RootDirectories.Add(AdditionalRootDirectory.Path);
+	}
+
+	if(SuperManagerSettings->bAlwaysCookedAssetsAreRoots)
+	{
+		const UProjectPackagingSettings* PackagingSettings = GetDefault<UProjectPackagingSettings>();
+
+		for(const FDirectoryPath& DirectoryToAlwaysCook : PackagingSettings->DirectoriesToAlwaysCook)
+		{
+			RootDirectories.Add(DirectoryToAlwaysCook.Path);
+		}
+
+		for(const FFilePath& MapToCook : PackagingSettings->MapsToCook)
+		{
+			AddRootPackage(FName(FPackageName::ObjectPathToPackageName(MapToCook.FilePath)));
+		}
+	}
+
+	for(FString& RootDirectory : RootDirectories)
+	{
+		if(!RootDirectory.EndsWith(TEXT("/"))) RootDirectory.AppendChar(TEXT('/'));
+	}
+
+	if(RootDirectories.Num() == 0 && !SuperManagerSettings->bNonProjectContentIsRoot) return;
+
+	for(int32 PackageIndex = 0; PackageIndex < ReferenceGraph.GetNumPackages(); ++PackageIndex)
+	{
+		if(!ReferenceGraph.DoesPackageExist(PackageIndex)) continue;
+
+		const FString PackageName = ReferenceGraph.GetPackageName(PackageIndex).ToString();
+
+		bool bIsRootPackage = SuperManagerSettings->bNonProjectContentIsRoot && !PackageName.StartsWith(TEXT("/Game/"));
+
+		for(int32 DirectoryIndex = 0; !bIsRootPackage && DirectoryIndex < RootDirectories.Num(); ++DirectoryIndex)
+		{
+			bIsRootPackage = PackageName.StartsWith(RootDirectories[DirectoryIndex]);
+		}
+
+		if(bIsRootPackage) OutRootPackageIndices.Add(PackageIndex);
+	}
+}
+
+void FSuperManagerModule::OnAssetRegistryFilesLoaded()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	BuildAssetReferenceGraph(AssetRegistry);
+}
+
+void FSuperManagerModule::OnAssetAddedToRegistry(const FAssetData& AddedAssetData)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	//Ignored by the graph until the initial build, which picks up everything discovered before it
+	AssetReferenceGraph.AddAsset(AssetRegistry, AddedAssetData, &AssetScanCache);
+}
+
+void FSuperManagerModule::OnAssetRemovedFromRegistry(const FAssetData& RemovedAssetData)
+{
+	AssetReferenceGraph.RemoveAsset(RemovedAssetData, &AssetScanCache);
+
+	RemoveMissingPackageFromCaches(RemovedAssetData.PackageName);
+}
+
+void FSuperManagerModule::OnAssetRenamedInRegistry(const FAssetData& RenamedAssetData, const FString& OldObjectPath)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	const FName OldPackageName(FPackageName::ObjectPathToPackageName(OldObjectPath));
+
+	AssetReferenceGraph.RenameAsset(AssetRegistry, RenamedAssetData, OldPackageName, &AssetScanCache);
+
+	RemoveMissingPackageFromCaches(OldPackageName);
+}
+
+void FSuperManagerModule::RemoveMissingPackageFromCaches(FName PackageName)
+{
+	//Other assets may still live in the package, its hashes stay until the last one leaves
+	if(DoesPackageExist(PackageName)) return;
+
+	if(bAssetContentHashCacheLoaded)
+	{
+		AssetContentHashCache.RemoveContentHash(PackageName);
+	}
+
+	if(bPerceptualHashCacheLoaded)
+	{
+		PerceptualHashCache.RemoveSourceHash(PackageName);
+	}
+
+	if(bGeometryHashCacheLoaded)
+	{
+		GeometryHashCache.RemoveSourceHash(PackageName);
+	}
+}
+
+void FSuperManagerModule::OnAssetUpdatedInRegistry(const FAssetData& UpdatedAssetData)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	AssetReferenceGraph.RefreshPackage(AssetRegistry, UpdatedAssetData.PackageName, &AssetScanCache);
+}
+
+#pragma endregion
+
+void FSuperManagerModule::ShutdownModule()
+{
+	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
+	// we call this function before unloading the module.
+	//Saved while the reference graph is still built, pruning needs it to tell deleted packages apart
+	SaveAssetContentHashCache();
+	SavePerceptualHashCache();
+	SaveGeometryHashCache();
+
+	ShutdownAssetReferenceTracking();
+
+	ShutdownAssetPathFilter();
+
+	if(IsRunningCommandlet()) return;
+
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FName("AdvancedDelete"));
 
 	FSuperManagerStyle::ShutDown();
@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SlateWidgets/AdvancedDeleteWidget.h"
+#include "AssetScanning/AsyncAssetDataGatherer.h"
+#include "Slate/WidgetRenderer.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Widgets/Views/STreeView.h"
+
+#define ScrollTestNumItems 100000
+#define ScrollTestNumFolders 500
+
+//Every frame jumps this many rows, so no row of one frame is on screen the next
+#define ScrollTestNumFrames 240
+#define ScrollTestRowsPerFrame 37
+
+#define ScrollTestDrawSize FVector2D(1280.f, 720.f)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAdvancedDeleteListScrollTest, "SuperManager.AdvancedDelete.ListScroll",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FAdvancedDeleteListScrollTest::RunTest(const FString& Parameters)
+{
+	TArray<FGatheredAssetData> GatheredAssetsData;
+	GatheredAssetsData.SetNum(ScrollTestNumItems);
+
+	const FTopLevelAssetPath AssetClassPath(TEXT("/Script/Engine"), TEXT("Texture2D"));
+
+	//Packages that do not exist, the list only displays what the asset data says about them
+	for(int32 ItemIndex = 0; ItemIndex < ScrollTestNumItems; ++ItemIndex)
+	{
+		const FString PackagePath = FString::Printf(TEXT("/Game/ScrollTest/Folder%03d"), ItemIndex % ScrollTestNumFolders);
+		const FString AssetName = FString::Printf(TEXT("T_ScrollTest_%06d"), ItemIndex);
+
+		GatheredAssetsData[ItemIndex].AssetData = FAssetData(FName(PackagePath / AssetName), FName(PackagePath), FName(AssetName), AssetClassPath);
+	}
+
+	TSharedRef<SAdvancedDeleteTab> AdvancedDeleteTab = SNew(SAdvancedDeleteTab);
+	AdvancedDeleteTab->AddItemsForTesting(MoveTemp(GatheredAssetsData));
+
+	TSharedPtr<STreeView<TSharedPtr<FAdvancedDeleteListItem>>> AssetListView = AdvancedDeleteTab->GetAssetListViewForTesting();
+
+	if(!TestTrue(TEXT("The tab constructs its asset list"), AssetListView.IsValid())) return false;
+
+	FWidgetRenderer WidgetRenderer(false);
+	TStrongObjectPtr<UTextureRenderTarget2D> RenderTarget(FWidgetRenderer::CreateTargetFor(ScrollTestDrawSize, TF_Bilinear, false));
+
+	//The first frame constructs one screen of rows, every later frame should only hand them new items
+	WidgetRenderer.DrawWidget(RenderTarget.Get(), AdvancedDeleteTab, ScrollTestDrawSize, 0.f);
+
+	const int32 NumFirstFrameRows = AdvancedDeleteTab->GetNumConstructedRowsForTesting();
+
+	if(!TestTrue(TEXT("The first frame constructs rows"), NumFirstFrameRows > 0)) return false;
+
+	double TotalFrameTime = 0.0;
+
+	for(int32 FrameIndex = 1; FrameIndex <= ScrollTestNumFrames; ++FrameIndex)
+	{
+		AssetListView->SetScrollOffset(FrameIndex * ScrollTestRowsPerFrame);
+
+		const double FrameStartTime = FPlatformTime::Seconds();
+		WidgetRenderer.DrawWidget(RenderTarget.Get(), AdvancedDeleteTab, ScrollTestDrawSize, 1.f / 60.f);
+		TotalFrameTime += FPlatformTime::Seconds() - FrameStartTime;
+	}
+
+	const int32 NumConstructedRows = AdvancedDeleteTab->GetNumConstructedRowsForTesting();
+	const double AverageFrameTime = TotalFrameTime / ScrollTestNumFrames;
+
+	//Wall clock time depends on the machine and build, so it is only reported, row reuse is what the test checks
+	AddInfo(FString::Printf(TEXT("%d rows constructed for %d items, %.2f ms per scrolled frame"),
+		NumConstructedRows, ScrollTestNumItems, AverageFrameTime * 1000.0));
+
+	//Rows of a slightly taller first layout may come on top, anything beyond a second screen means rows are not recycled
+	TestTrue(TEXT("Scrolling reuses the rows of the first frame"), NumConstructedRows <= NumFirstFrameRows * 2);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//Hash of a package file's payload, everything after the package header, together with the payload's size
+struct FAssetContentHash
+{
+	uint64 Hash = 0;
+
+	//-1 while the package is not hashed or could not be read
+	int64 PayloadSize = -1;
+
+	bool IsValid() const { return PayloadSize >= 0; }
+
+	bool operator==(const FAssetContentHash& Other) const { return Hash == Other.Hash && PayloadSize == Other.PayloadSize; }
+
+	friend uint32 GetTypeHash(const FAssetContentHash& ContentHash) { return GetTypeHash(ContentHash.Hash); }
+};
+
+/**
+ * Content hashes of package files persisted under Saved/SuperManager between editor sessions.
+ * An entry is only reused while the package file still has the time stamp it was hashed at, so a rescan only reads changed files.
+ */
+class FAssetContentHashCache
+{
+public:
+	static FString GetDefaultCacheFilePath();
+
+	bool Load(const FString& CacheFilePath);
+	bool Save(const FString& CacheFilePath);
+
+	const FAssetContentHash* FindContentHash(FName PackageName, const FDateTime& PackageTimeStamp) const;
+	void AddContentHash(FName PackageName, const FDateTime& PackageTimeStamp, const FAssetContentHash& ContentHash);
+
+	void RemoveContentHash(FName PackageName);
+
+	//Drops the hashes of packages deleted or renamed since they were hashed, including while the editor was closed
+	void RemoveMissingPackages(TFunctionRef<bool(FName)> DoesPackageExist);
+
+	//Whether hashes were added since the cache was loaded or saved
+	bool IsDirty() const { return bDirty; }
+
+private:
+	struct FCachedContentHash
+	{
+		FDateTime PackageTimeStamp;
+		FAssetContentHash ContentHash;
+	};
+
+	TMap<FName, FCachedContentHash> ContentHashes;
+
+	bool bDirty = false;
+};
@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Settings/SuperManagerSettings.h"
+
+/**
+ * Path rules compiled into a trie over FName path components.
+ * Matching a path costs one name lookup per folder level and never matches partial folder names.
+ * Read only once compiled, so it can be shared with worker threads.
+ */
+class FAssetPathFilter
+{
+public:
+	void Compile(const TArray<FSuperManagerPathRule>& PathRules);
+
+	bool IsPathExcluded(FStringView Path) const;
+	bool IsPathExcluded(FName Path) const;
+
+private:
+	struct FPathTrieNode
+	{
+		TMap<FName, int32> Children;
+
+		bool bHasRule = false;
+		bool bExcludes = false;
+	};
+
+	TArray<FPathTrieNode> Nodes;
+};
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IAssetRegistry;
+class FAssetScanCache;
+struct FAssetData;
+struct FIoHash;
+struct FAssetIdentifier;
+
+enum class EPackageReferenceType : uint8
+{
+	None = 0,
+	Hard = 1 << 0,
+	Soft = 1 << 1,
+	Management = 1 << 2,
+
+	Package = Hard | Soft,
+	All = Hard | Soft | Management
+};
+ENUM_CLASS_FLAGS(EPackageReferenceType)
+
+struct FPackageReference
+{
+	int32 PackageIndex = INDEX_NONE;
+	EPackageReferenceType ReferenceType = EPackageReferenceType::None;
+};
+
+/**
+ * Referencer graph over every on disk package known to the asset registry, built in a single scan.
+ * Packages are addressed by a dense index, so asking whether a package is referenced is one array read.
+ * After the initial build, registry events are applied per package to keep the unreferenced set current.
+ */
+class FAssetReferenceGraph
+{
+public:
+	void Build(IAssetRegistry& AssetRegistry, FAssetScanCache* ScanCache = nullptr);
+	void Reset();
+
+	bool IsBuilt() const { return bIsBuilt; }
+
+#pragma region IncrementalUpdate
+
+	//The scan cache, when given, is kept in step so the next build reuses what these re-gather
+	void AddAsset(IAssetRegistry& AssetRegistry, const FAssetData& AddedAssetData, FAssetScanCache* ScanCache = nullptr);
+	void RemoveAsset(const FAssetData& RemovedAssetData, FAssetScanCache* ScanCache = nullptr);
+	void RenameAsset(IAssetRegistry& AssetRegistry, const FAssetData& RenamedAssetData, FName OldPackageName, FAssetScanCache* ScanCache = nullptr);
+	void RefreshPackage(IAssetRegistry& AssetRegistry, FName PackageName, FAssetScanCache* ScanCache = nullptr);
+
+	//Packages whose hard or soft referencer count changed since the last call, in no particular order
+	void ConsumeReferencerCountChanges(TArray<FName>& OutPackageNames);
+
+#pragma endregion
+
+	int32 GetNumPackages() const { return PackageNames.Num(); }
+	int32 FindPackageIndex(FName PackageName) const;
+	FName GetPackageName(int32 PackageIndex) const { return PackageNames[PackageIndex]; }
+
+	//On disk size reported by the registry, -1 when unknown
+	int64 GetPackageDiskSize(int32 PackageIndex) const { return PackageDiskSizes[PackageIndex]; }
+
+	const TArray<FPackageReference>& GetDependencies(int32 PackageIndex) const { return Dependencies[PackageIndex]; }
+	const TArray<FPackageReference>& GetReferencers(int32 PackageIndex) const { return Referencers[PackageIndex]; }
+
+	int32 GetNumReferencers(int32 PackageIndex, EPackageReferenceType ReferenceTypes = EPackageReferenceType::Package) const;
+
+	bool IsPackageUnreferenced(FName PackageName) const;
+	bool IsAssetUnreferenced(const FAssetData& AssetData) const;
+
+	const TBitArray<>& GetUnreferencedPackages() const { return UnreferencedPackages; }
+	void GetUnreferencedPackageNames(TArray<FName>& OutPackageNames) const;
+
+	bool DoesPackageExist(int32 PackageIndex) const { return PackageAssetCounts[PackageIndex] > 0; }
+
+	//Marks every package reachable from the roots through any reference type, in one pass over the edges
+	void MarkReachablePackages(const TArray<int32>& RootPackageIndices, TBitArray<>& OutReachablePackages) const;
+
+private:
+	int32 FindOrAddPackage(FName PackageName);
+
+	void RemovePackageReferences(int32 PackageIndex);
+
+	void RemoveReference(int32 ReferencerIndex, int32 DependencyIndex, EPackageReferenceType ReferenceTypes);
+
+	void UpdateUnreferencedState(int32 PackageIndex);
+
+	void ChangeReferencerCount(int32 PackageIndex, int32 Delta);
+
+	void GatherPackageDependencies(IAssetRegistry& AssetRegistry, int32 PackageIndex, FAssetScanCache* ScanCache);
+	void GatherPackageDependencies(IAssetRegistry& AssetRegistry, int32 PackageIndex, const FIoHash& PackageSavedHash, int64 RegistryDiskSize, FAssetScanCache* ScanCache);
+
+	void AddReference(int32 ReferencerIndex, int32 DependencyIndex, EPackageReferenceType ReferenceType);
+
+	static FName GetManagerPackageName(const FAssetIdentifier& ManagerIdentifier);
+
+	TArray<FName> PackageNames;
+	TMap<FName, int32> PackageIndexMap;
+
+	TArray<TArray<FPackageReference>> Dependencies;
+	TArray<TArray<FPackageReference>> Referencers;
+
+	//Number of packages hard or soft referencing each package, the same set FindPackageReferencersForAsset reports
+	TArray<int32> PackageReferencerCounts;
+
+	//Number of registry assets living in each package, zero for packages only known as a dependency target
+	TArray<int32> PackageAssetCounts;
+
+	TArray<int64> PackageDiskSizes;
+
+	//Only recorded once built, the initial build changes every count
+	TSet<int32> ReferencerCountChangedPackages;
+
+	TBitArray<> UnreferencedPackages;
+
+	bool bIsBuilt = false;
+};
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+#include "AssetScanning/AssetReferenceGraph.h"
+
+struct FCachedPackageDependency
+{
+	FName PackageName;
+	EPackageReferenceType ReferenceType = EPackageReferenceType::None;
+};
+
+struct FCachedPackageScan
+{
+	FIoHash PackageSavedHash;
+	int64 DiskSize = 0;
+	TArray<FCachedPackageDependency> Dependencies;
+
+	//Transient, entries not touched during a build are dropped before saving
+	bool bUsedThisBuild = false;
+};
+
+/**
+ * Per package scan results persisted under Saved/SuperManager between editor sessions.
+ * An entry is only reused while the package's saved hash still matches the one it was scanned with.
+ */
+class FAssetScanCache
+{
+public:
+	static FString GetDefaultCacheFilePath();
+
+	bool Load(const FString& CacheFilePath);
+	bool Save(const FString& CacheFilePath);
+
+	const FCachedPackageScan* FindPackageScan(FName PackageName, const FIoHash& PackageSavedHash);
+	void AddPackageScan(FName PackageName, FCachedPackageScan&& PackageScan);
+	void RemovePackageScan(FName PackageName);
+
+	void RemoveUnusedPackageScans();
+
+	int32 GetNumPackageScans() const { return PackageScans.Num(); }
+
+	//Whether scans were added or removed since the cache was loaded or saved
+	bool IsDirty() const { return bDirty; }
+
+private:
+	TMap<FName, FCachedPackageScan> PackageScans;
+
+	bool bDirty = false;
+};
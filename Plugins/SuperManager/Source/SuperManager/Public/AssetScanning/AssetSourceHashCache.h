@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+
+/**
+ * Hashes read from loaded assets, such as the looks of textures, persisted under Saved/SuperManager between editor sessions.
+ * An entry is only reused while the package still has the saved hash it was read at, so only resaved assets are loaded again.
+ */
+class FAssetSourceHashCache
+{
+public:
+	static FString GetCacheFilePath(const TCHAR* CacheFileName);
+
+	bool Load(const FString& CacheFilePath);
+	bool Save(const FString& CacheFilePath);
+
+	const uint64* FindSourceHash(FName PackageName, const FIoHash& PackageSavedHash) const;
+	void AddSourceHash(FName PackageName, const FIoHash& PackageSavedHash, uint64 SourceHash);
+
+	void RemoveSourceHash(FName PackageName);
+
+	//Drops the hashes of packages deleted or renamed since they were read, including while the editor was closed
+	void RemoveMissingPackages(TFunctionRef<bool(FName)> DoesPackageExist);
+
+	//Whether hashes were added since the cache was loaded or saved
+	bool IsDirty() const { return bDirty; }
+
+private:
+	struct FCachedSourceHash
+	{
+		FIoHash PackageSavedHash;
+		uint64 SourceHash = 0;
+	};
+
+	TMap<FName, FCachedSourceHash> SourceHashes;
+
+	bool bDirty = false;
+};
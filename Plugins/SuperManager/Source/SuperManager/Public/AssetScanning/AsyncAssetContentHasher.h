@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetScanning/AssetContentHashCache.h"
+
+struct FAssetContentHashRequest
+{
+	int32 ItemIndex = INDEX_NONE;
+	FName PackageName;
+	FDateTime PackageTimeStamp;
+};
+
+struct FAssetContentHashResult
+{
+	int32 ItemIndex = INDEX_NONE;
+	FName PackageName;
+
+	//Time stamp the request was made with, the hash is cached against it
+	FDateTime PackageTimeStamp;
+
+	//Invalid when the package file could not be found or read
+	FAssetContentHash ContentHash;
+};
+
+/**
+ * Hashes package files on pool threads, one task per enqueued batch with the files spread over workers.
+ * Files are streamed through xxHash64 after the package header, which holds the package guid, saved hash and engine version.
+ * Exports refer to names by their index in the package's name map, and where the package's own name sorts in that map
+ * shifts the indices. So the names are hashed in an order that ignores the package's own name, and every name in the
+ * exports is hashed by its index in that order. Two packages saved from identical assets under different names still hash the same.
+ */
+class FAsyncAssetContentHasher : public TSharedFromThis<FAsyncAssetContentHasher, ESPMode::ThreadSafe>
+{
+public:
+	void Enqueue(TArray<FAssetContentHashRequest>&& HashRequests);
+	void Cancel();
+
+	bool IsIdle() const { return NumPendingBatches == 0; }
+
+	//Moves every finished result to the end of the output, returns how many were moved
+	int32 ConsumeHashResults(TArray<FAssetContentHashResult>& OutHashResults);
+
+private:
+	void HashOnWorkerThread(const TArray<FAssetContentHashRequest>& HashRequests);
+
+	FAssetContentHash HashPackageFile(FName PackageName, TArray<uint8>& ReadBuffer) const;
+
+	static FString FindPackageFilename(FName PackageName);
+
+	FCriticalSection FinishedHashResultsLock;
+	TArray<FAssetContentHashResult> FinishedHashResults;
+
+	std::atomic<bool> bCancelRequested = false;
+	std::atomic<int32> NumPendingBatches = 0;
+};
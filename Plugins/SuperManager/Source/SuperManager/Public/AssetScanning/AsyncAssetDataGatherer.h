@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetScanning/AssetPathFilter.h"
+
+struct FGatheredAssetData
+{
+	FAssetData AssetData;
+
+	//Timestamp of the package file, FDateTime::MinValue() when the file could not be found
+	FDateTime PackageTimeStamp = FDateTime::MinValue();
+};
+
+/**
+ * Gathers the on disk assets under a set of folders on a pool thread, with one recursive registry query.
+ * The result is handed over in chunks, so a widget can display them while the rest is still being processed.
+ * Redirectors and assets in excluded folders are skipped, the path filter is copied so settings changes cannot race the worker.
+ */
+class FAsyncAssetDataGatherer : public TSharedFromThis<FAsyncAssetDataGatherer, ESPMode::ThreadSafe>
+{
+public:
+	FAsyncAssetDataGatherer(const TArray<FString>& InRootFolderPaths, const FAssetPathFilter& InAssetPathFilter);
+
+	void Start();
+	void Cancel();
+
+	bool IsComplete() const { return bIsComplete; }
+
+	//Total gathered so far, including assets not consumed yet
+	int32 GetNumGatheredAssets() const { return NumGatheredAssets; }
+
+	//Moves at most MaxAssets gathered assets to the end of the output, returns how many were moved
+	int32 ConsumeGatheredAssetsData(TArray<FGatheredAssetData>& OutAssetsData, int32 MaxAssets);
+
+	//Timestamp of the package file, looked up once per package in the given cache
+	static FDateTime GetPackageTimeStamp(FName PackageName, TMap<FName, FDateTime>& PackageTimeStamps);
+
+private:
+	void GatherOnWorkerThread();
+
+	TArray<FString> RootFolderPaths;
+	FAssetPathFilter AssetPathFilter;
+
+	FCriticalSection PendingAssetsDataLock;
+	TArray<FGatheredAssetData> PendingAssetsData;
+
+	//Pending assets before this index were already consumed, they are dropped in bulk rather than shifted out per batch
+	int32 NumConsumedPendingAssets = 0;
+
+	std::atomic<bool> bCancelRequested = false;
+	std::atomic<bool> bIsComplete = false;
+	std::atomic<int32> NumGatheredAssets = 0;
+};
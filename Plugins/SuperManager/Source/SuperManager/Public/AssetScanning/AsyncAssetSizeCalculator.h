@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+struct FAssetSizeRequest
+{
+	int32 ItemIndex = INDEX_NONE;
+	FAssetData AssetData;
+};
+
+struct FAssetSizeResult
+{
+	int32 ItemIndex = INDEX_NONE;
+
+	//Size of the package file on disk, -1 when the file could not be found
+	int64 DiskSize = -1;
+
+	//Resource size the asset reports through its registry tags, -1 for classes that do not export one
+	int64 MemorySize = -1;
+};
+
+/**
+ * Computes asset sizes on pool threads, one task per enqueued batch with the package file stats spread over workers.
+ * Assets are never loaded, memory sizes only come from what the asset registry already knows.
+ */
+class FAsyncAssetSizeCalculator : public TSharedFromThis<FAsyncAssetSizeCalculator, ESPMode::ThreadSafe>
+{
+public:
+	void Enqueue(TArray<FAssetSizeRequest>&& SizeRequests);
+	void Cancel();
+
+	bool IsIdle() const { return NumPendingBatches == 0; }
+
+	//Moves every finished result to the end of the output, returns how many were moved
+	int32 ConsumeSizeResults(TArray<FAssetSizeResult>& OutSizeResults);
+
+private:
+	void CalculateOnWorkerThread(const TArray<FAssetSizeRequest>& SizeRequests);
+
+	static int64 GetPackageFileSize(FName PackageName);
+	static int64 GetRegistryResourceSize(const FAssetData& AssetData);
+
+	FCriticalSection FinishedSizeResultsLock;
+	TArray<FAssetSizeResult> FinishedSizeResults;
+
+	std::atomic<bool> bCancelRequested = false;
+	std::atomic<int32> NumPendingBatches = 0;
+};
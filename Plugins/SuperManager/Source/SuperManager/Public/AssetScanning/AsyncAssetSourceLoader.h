@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+#include "UObject/SoftObjectPath.h"
+
+struct FAssetData;
+class UPackage;
+
+struct FLoadedAssetSource
+{
+	int32 ItemIndex = INDEX_NONE;
+
+	TWeakObjectPtr<UObject> Asset;
+
+	//Saved hash the package had when it was requested, hashes read from the asset are cached against it
+	FIoHash PackageSavedHash;
+
+	//Only packages the loader loaded itself are released once read
+	bool bLoadedByLoader = false;
+
+	//Hard imports, such as a mesh's materials and their textures, that only became loaded along with the asset
+	TArray<FName> LoadedImportPackageNames;
+};
+
+/**
+ * Loads assets on the game thread for reading their source data, with only a few package loads in flight at a time.
+ * Assets already in memory are handed over as they are. Packages loaded here are released once read, together with
+ * the hard imports that were not loaded before the request: their objects lose RF_Standalone and the garbage is
+ * collected after every few packages, so reading thousands of assets never keeps them or what they import loaded.
+ */
+class FAsyncAssetSourceLoader : public TSharedFromThis<FAsyncAssetSourceLoader>
+{
+public:
+	void Enqueue(int32 ItemIndex, const FAssetData& AssetData, const FIoHash& PackageSavedHash);
+	void Cancel();
+
+	bool IsIdle() const { return PendingLoads.Num() == 0 && NumLoadsInFlight == 0 && LoadedAssets.Num() == 0; }
+
+	//Moves up to the given number of loaded assets to the end of the output, returns how many were moved
+	int32 ConsumeLoadedAssets(TArray<FLoadedAssetSource>& OutLoadedAssets, int32 MaxLoadedAssets);
+
+	//Lets go of an asset once it is read, a package loaded here becomes garbage unless it was edited meanwhile
+	void Release(const FLoadedAssetSource& LoadedAsset);
+
+	//Collects released packages once enough of them piled up, or right away when forced
+	void CollectReleasedPackages(bool bForce);
+
+private:
+	struct FPendingLoad
+	{
+		int32 ItemIndex = INDEX_NONE;
+		FSoftObjectPath AssetPath;
+		FIoHash PackageSavedHash;
+
+		//Imports not loaded when the load started, the ones loaded by the time it finishes are released with the asset
+		TArray<FName> UnloadedImportPackageNames;
+	};
+
+	void StartPendingLoads();
+
+	//Lets go of one package, unless it was edited meanwhile
+	void ReleasePackage(UPackage* Package);
+
+	TArray<FPendingLoad> PendingLoads;
+
+	//Loaded and waiting to be read, counted with the loads in flight against the limit
+	TArray<FLoadedAssetSource> LoadedAssets;
+
+	int32 NumLoadsInFlight = 0;
+	int32 NumReleasedPackages = 0;
+
+	bool bCancelRequested = false;
+};
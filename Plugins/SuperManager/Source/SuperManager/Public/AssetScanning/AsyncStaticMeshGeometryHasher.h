@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+
+class UStaticMesh;
+struct FMeshDescription;
+
+//Triangle corners of a static mesh's first source model, three corners per triangle in the source's order
+struct FStaticMeshGeometry
+{
+	TArray<FVector3f> CornerPositions;
+
+	//Every UV channel of a corner after each other, NumUVChannels per corner
+	TArray<FVector2f> CornerUVs;
+	int32 NumUVChannels = 0;
+
+	//Copies the corners out of the first source model, false when the mesh has no source geometry to read.
+	//A mesh description the mesh has not cached is loaded into a local copy, so reading leaves the mesh as it was.
+	bool ReadFromStaticMesh(const UStaticMesh& StaticMesh);
+
+private:
+	bool ReadFromMeshDescription(const FMeshDescription& MeshDescription);
+};
+
+struct FStaticMeshGeometryHashResult
+{
+	int32 ItemIndex = INDEX_NONE;
+	FName PackageName;
+
+	//Saved hash the package had when its source model was read, the hash is cached against it
+	FIoHash PackageSavedHash;
+
+	uint64 GeometryHash = 0;
+};
+
+/**
+ * Hashes static mesh geometry on pool threads, one task per enqueued mesh.
+ * Reading the mesh description needs the loaded mesh, so the caller reads it on the game thread and only hands over the corners.
+ * Corners are hashed from their quantized position and UVs, each triangle is rotated to start at its lowest corner
+ * and the triangle hashes are sorted, so meshes differing only in vertex or triangle order hash the same.
+ */
+class FAsyncStaticMeshGeometryHasher : public TSharedFromThis<FAsyncStaticMeshGeometryHasher, ESPMode::ThreadSafe>
+{
+public:
+	void Enqueue(int32 ItemIndex, FName PackageName, const FIoHash& PackageSavedHash, FStaticMeshGeometry&& Geometry);
+	void Cancel();
+
+	bool IsIdle() const { return NumPendingMeshes == 0; }
+
+	//Bytes of geometry enqueued and not hashed yet, callers stop reading meshes while this is high
+	int64 GetNumPendingGeometryBytes() const { return NumPendingGeometryBytes; }
+
+	//Moves every finished result to the end of the output, returns how many were moved
+	int32 ConsumeHashResults(TArray<FStaticMeshGeometryHashResult>& OutHashResults);
+
+	static uint64 ComputeGeometryHash(const FStaticMeshGeometry& Geometry);
+
+private:
+	FCriticalSection FinishedHashResultsLock;
+	TArray<FStaticMeshGeometryHashResult> FinishedHashResults;
+
+	std::atomic<bool> bCancelRequested = false;
+	std::atomic<int32> NumPendingMeshes = 0;
+	std::atomic<int64> NumPendingGeometryBytes = 0;
+};
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+
+struct FImage;
+
+struct FTexturePerceptualHashResult
+{
+	int32 ItemIndex = INDEX_NONE;
+	FName PackageName;
+
+	//Saved hash the package had when its source was read, the hash is cached against it
+	FIoHash PackageSavedHash;
+
+	//Bit per low frequency of the texture's luminance, textures looking alike differ in few bits
+	uint64 PerceptualHash = 0;
+};
+
+/**
+ * Computes perceptual hashes of texture source images on pool threads, one task per enqueued image.
+ * Reading the source needs the loaded texture, so the caller reads it on the game thread and only hands over the image.
+ * Images are shrunk to 32x32 luminance, the hash keeps the sign of the lowest 8x8 DCT frequencies against their median.
+ */
+class FAsyncTexturePerceptualHasher : public TSharedFromThis<FAsyncTexturePerceptualHasher, ESPMode::ThreadSafe>
+{
+public:
+	void Enqueue(int32 ItemIndex, FName PackageName, const FIoHash& PackageSavedHash, FImage&& SourceImage);
+	void Cancel();
+
+	bool IsIdle() const { return NumPendingImages == 0; }
+
+	//Bytes of source images enqueued and not hashed yet, callers stop reading sources while this is high
+	int64 GetNumPendingImageBytes() const { return NumPendingImageBytes; }
+
+	//Moves every finished result to the end of the output, returns how many were moved
+	int32 ConsumeHashResults(TArray<FTexturePerceptualHashResult>& OutHashResults);
+
+	static uint64 ComputePerceptualHash(const FImage& SourceImage);
+
+	//Source mip closest above the hashed resolution, so large sources with mips are not read in full
+	static int32 GetSourceMipToHash(int32 SizeX, int32 SizeY, int32 NumMips);
+
+private:
+	FCriticalSection FinishedHashResultsLock;
+	TArray<FTexturePerceptualHashResult> FinishedHashResults;
+
+	std::atomic<bool> bCancelRequested = false;
+	std::atomic<int32> NumPendingImages = 0;
+	std::atomic<int64> NumPendingImageBytes = 0;
+};
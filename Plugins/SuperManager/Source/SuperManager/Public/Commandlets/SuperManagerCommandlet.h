@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SuperManagerCommandlet.generated.h"
+
+/**
+ * Headless unused asset and empty folder audit.
+ * Usage: UnrealEditor-Cmd Project.uproject -run=SuperManager -nullrhi [-Path=/Game/A+/Game/B] [-Report=<file without extension>] [-Format=Json|Csv|Both]
+ */
+UCLASS()
+class SUPERMANAGER_API USuperManagerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USuperManagerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	void EndPhase(const TCHAR* PhaseName);
+
+	double PhaseStartTime = 0.0;
+
+	TArray<TPair<FString, double>> PhaseTimings;
+
+#pragma region ReportWriting
+
+	void WriteJsonReport(FArchive& ReportArchive, const FString& ScanPath, const TArray<FAssetData>& UnusedAssetsData,
+		const TArray<FString>& EmptyFolderPaths, int32 NumScannedAssets);
+
+	void WriteCsvReport(FArchive& ReportArchive, const TArray<FAssetData>& UnusedAssetsData);
+	void WriteCsvTimings(FArchive& TimingsArchive);
+
+	int64 GetPackageDiskSize(FName PackageName) const;
+	int32 GetPackageReferencerCount(FName PackageName) const;
+
+	static void WriteUTF8(FArchive& Archive, const FString& Text);
+	static FString EscapeJsonString(const FString& Text);
+	static FString EscapeCsvField(const FString& Field);
+
+#pragma endregion
+};
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "SuperManagerSettings.generated.h"
+
+UENUM(BlueprintType)
+enum class E_PathRuleType : uint8
+{
+	EPRT_Exclude UMETA (DisplayName = "Exclude"),
+
+	EPRT_Include UMETA (DisplayName = "Include")
+};
+
+USTRUCT(BlueprintType)
+struct FSuperManagerPathRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PathRule", meta = (ContentDir, LongPackageName))
+	FDirectoryPath Directory;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PathRule")
+	E_PathRuleType RuleType = E_PathRuleType::EPRT_Exclude;
+};
+
+/**
+ * 
+ */
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Super Manager"))
+class SUPERMANAGER_API USuperManagerSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	USuperManagerSettings();
+
+#pragma region ReachabilityRoots
+
+	UPROPERTY(config, EditAnywhere, Category = "ReachabilityRoots")
+	bool bMapsAreRoots = true;
+
+	UPROPERTY(config, EditAnywhere, Category = "ReachabilityRoots")
+	bool bPrimaryAssetsAreRoots = true;
+
+	UPROPERTY(config, EditAnywhere, Category = "ReachabilityRoots", meta = (ToolTip = "Maps to cook and directories to always cook from the packaging settings"))
+	bool bAlwaysCookedAssetsAreRoots = true;
+
+	UPROPERTY(config, EditAnywhere, Category = "ReachabilityRoots", meta = (ToolTip = "Engine and plugin content, everything outside /Game"))
+	bool bNonProjectContentIsRoot = true;
+
+	UPROPERTY(config, EditAnywhere, Category = "ReachabilityRoots", meta = (ContentDir, LongPackageName))
+	TArray<FDirectoryPath> AdditionalRootDirectories;
+
+#pragma endregion
+
+#pragma region PathFilter
+
+	UPROPERTY(config, EditAnywhere, Category = "PathFilter", meta = (ToolTip = "Folders skipped by every scan. The deepest rule matching a path wins, so an include rule can reopen a folder under an excluded one"))
+	TArray<FSuperManagerPathRule> PathRules;
+
+#pragma endregion
+
+#pragma region DuplicateDetection
+
+	UPROPERTY(config, EditAnywhere, Category = "DuplicateDetection", meta = (ClampMin = 0, ClampMax = 32, ToolTip = "Textures whose 64 bit perceptual hashes differ in at most this many bits are listed as similar"))
+	int32 SimilarTextureMaxHashDistance = 6;
+
+#pragma endregion
+};
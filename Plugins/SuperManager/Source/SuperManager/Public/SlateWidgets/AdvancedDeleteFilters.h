@@ -0,0 +1,170 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SlateWidgets/AdvancedDeleteListItem.h"
+
+class FAssetReferenceGraph;
+
+namespace AdvancedDeleteFilterIds
+{
+	static const FName Unused(TEXT("Unused"));
+	static const FName Unreachable(TEXT("Unreachable"));
+	static const FName SameName(TEXT("SameName"));
+	static const FName SameContent(TEXT("SameContent"));
+	static const FName SimilarTextures(TEXT("SimilarTextures"));
+	static const FName SameGeometry(TEXT("SameGeometry"));
+}
+
+//Data a filter reads, memoized results of a filter are dropped when any of its inputs changes
+enum class EAdvancedDeleteFilterInputs : uint8
+{
+	None = 0,
+	AssetData = 1 << 0,
+	ReferenceGraph = 1 << 1,
+	AssetSizes = 1 << 2,
+
+	//The result for one item depends on the other items, such as sharing a name with another one
+	AllItems = 1 << 3,
+
+	ContentHashes = 1 << 4,
+	PerceptualHashes = 1 << 5,
+	GeometryHashes = 1 << 6,
+
+	//The result for one item depends on references between other packages, such as being reachable from the roots
+	ReferencePaths = 1 << 7
+};
+ENUM_CLASS_FLAGS(EAdvancedDeleteFilterInputs)
+
+struct FAdvancedDeleteFilterContext
+{
+	FAdvancedDeleteFilterContext(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& InAllItems, const FAssetReferenceGraph& InReferenceGraph,
+		int32 InNumItemIndices)
+		: AllItems(InAllItems)
+		, ReferenceGraph(InReferenceGraph)
+		, NumItemIndices(InNumItemIndices)
+	{
+	}
+
+	//Every stored item, not only the ones being filtered
+	const TArray<TSharedPtr<FAdvancedDeleteListItem>>& AllItems;
+
+	const FAssetReferenceGraph& ReferenceGraph;
+
+	//One past the highest item index handed out so far
+	int32 NumItemIndices = 0;
+};
+
+/**
+ * One listing condition of the Advanced Delete tab.
+ * The cost is relative to the other filters, cheaper filters are tested first so the expensive ones see fewer items.
+ */
+class FAdvancedDeleteFilter
+{
+public:
+	FAdvancedDeleteFilter(FName InFilterId, const FString& InDisplayName, int32 InCost, EAdvancedDeleteFilterInputs InInputs)
+		: FilterId(InFilterId)
+		, DisplayName(FText::FromString(InDisplayName))
+		, Cost(InCost)
+		, Inputs(InInputs)
+	{
+	}
+
+	virtual ~FAdvancedDeleteFilter() = default;
+
+	FName GetFilterId() const { return FilterId; }
+	const FText& GetDisplayName() const { return DisplayName; }
+	int32 GetCost() const { return Cost; }
+	EAdvancedDeleteFilterInputs GetInputs() const { return Inputs; }
+
+	//Called before the first item is tested after the inputs changed, for work shared by every item
+	virtual void Prepare(const FAdvancedDeleteFilterContext& Context) {}
+
+	virtual bool PassesFilter(const FAdvancedDeleteListItem& Item, const FAdvancedDeleteFilterContext& Context) const = 0;
+
+private:
+	FName FilterId;
+	FText DisplayName;
+	int32 Cost = 1;
+	EAdvancedDeleteFilterInputs Inputs = EAdvancedDeleteFilterInputs::None;
+};
+
+//Filter testing each item on its own through a function
+class FAdvancedDeletePredicateFilter : public FAdvancedDeleteFilter
+{
+public:
+	using FPredicate = TFunction<bool(const FAdvancedDeleteListItem&, const FAdvancedDeleteFilterContext&)>;
+
+	FAdvancedDeletePredicateFilter(FName InFilterId, const FString& InDisplayName, int32 InCost, EAdvancedDeleteFilterInputs InInputs,
+		FPredicate&& InPredicate)
+		: FAdvancedDeleteFilter(InFilterId, InDisplayName, InCost, InInputs)
+		, Predicate(MoveTemp(InPredicate))
+	{
+	}
+
+	virtual bool PassesFilter(const FAdvancedDeleteListItem& Item, const FAdvancedDeleteFilterContext& Context) const override
+	{
+		return Predicate(Item, Context);
+	}
+
+private:
+	FPredicate Predicate;
+};
+
+/**
+ * Registered filters of the Advanced Delete tab, the active ones are combined with AND.
+ * Items are filtered in one pass, each item going through the active filters in cost order until one rejects it.
+ * Every filter remembers its result per item index until an input it declared changes.
+ */
+class FAdvancedDeleteFilterPipeline
+{
+public:
+	void RegisterFilter(TSharedRef<FAdvancedDeleteFilter> Filter);
+
+	//Unused, unreachable, same name, same content, similar textures, same geometry, a few asset classes and large assets
+	void RegisterBuiltInFilters();
+
+	int32 GetNumFilters() const { return RegisteredFilters.Num(); }
+	const FAdvancedDeleteFilter& GetFilter(int32 FilterIndex) const { return *RegisteredFilters[FilterIndex].Filter; }
+
+	void SetFilterActive(int32 FilterIndex, bool bActive);
+	bool IsFilterActive(int32 FilterIndex) const { return RegisteredFilters[FilterIndex].bActive; }
+	bool IsFilterActive(FName FilterId) const;
+
+	//Display names of the active filters joined with AND
+	FText GetActiveFiltersText() const;
+
+	bool DoActiveFiltersRead(EAdvancedDeleteFilterInputs Inputs) const;
+
+	void InvalidateInputs(EAdvancedDeleteFilterInputs ChangedInputs);
+
+	//For an item whose own data changed, filters reading other items are invalidated entirely
+	void InvalidateItem(int32 ItemIndex);
+
+	//For an item whose inputs changed without changing what the other items read, such as its referencer count
+	void InvalidateItemInputs(int32 ItemIndex, EAdvancedDeleteFilterInputs ChangedInputs);
+
+	//Appends the items passing every active filter to the output, keeping their order
+	void Evaluate(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToFilter, const FAdvancedDeleteFilterContext& Context,
+		TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutPassingItems);
+
+private:
+	struct FRegisteredFilter
+	{
+		explicit FRegisteredFilter(TSharedRef<FAdvancedDeleteFilter> InFilter) : Filter(InFilter) {}
+
+		TSharedRef<FAdvancedDeleteFilter> Filter;
+
+		bool bActive = false;
+		bool bPrepared = false;
+
+		//Memoized results by item index, a passing bit is only meaningful when the evaluated bit is set
+		TBitArray<> EvaluatedItems;
+		TBitArray<> PassingItems;
+	};
+
+	void ResetMemoizedResults(FRegisteredFilter& RegisteredFilter);
+
+	TArray<FRegisteredFilter> RegisteredFilters;
+};
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetReferenceGraph;
+struct FAdvancedDeleteListItem;
+
+struct FAdvancedDeleteFolderNode
+{
+	FName FolderPath;
+
+	int32 ParentIndex = INDEX_NONE;
+	int32 FirstChildIndex = INDEX_NONE;
+	int32 NextSiblingIndex = INDEX_NONE;
+
+	//Totals over the folder and everything below it
+	int32 NumAssets = 0;
+	int32 NumUnusedAssets = 0;
+	int64 DiskSize = 0;
+	int64 MemorySize = 0;
+};
+
+//Row of the folder tree view, child rows are only created once the tree asks for them
+struct FAdvancedDeleteFolderTreeItem
+{
+	explicit FAdvancedDeleteFolderTreeItem(int32 InNodeIndex) : NodeIndex(InNodeIndex) {}
+
+	int32 NodeIndex = INDEX_NONE;
+
+	TArray<TSharedPtr<FAdvancedDeleteFolderTreeItem>> ChildItems;
+	bool bChildItemsCreated = false;
+};
+
+/**
+ * Folders of a set of Advanced Delete items, stored in one array with parents always before their children.
+ * Items are added one at a time along their folder and every folder above it, so totals can also be kept up to date
+ * while items come and go without building the tree again.
+ */
+class FAdvancedDeleteFolderTree
+{
+public:
+	void Build(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items, const FAssetReferenceGraph& ReferenceGraph);
+
+	void Reset();
+
+	//Adds or, with a negative sign, takes back the item along its folder and every folder above it
+	void AddItem(const FAdvancedDeleteListItem& Item, int32 Sign = 1, bool bIsUnused = false);
+
+	int32 GetNumNodes() const { return Nodes.Num(); }
+	const FAdvancedDeleteFolderNode& GetNode(int32 NodeIndex) const { return Nodes[NodeIndex]; }
+
+	int32 FindNodeIndex(FName FolderPath) const;
+
+	void GetRootNodeIndices(TArray<int32>& OutNodeIndices) const;
+	void GetChildNodeIndices(int32 NodeIndex, TArray<int32>& OutNodeIndices) const;
+
+private:
+	int32 FindOrAddNode(FName FolderPath);
+
+	//Links a node in front of its siblings, the root nodes are siblings of each other
+	void LinkNode(int32 NodeIndex);
+
+	TArray<FAdvancedDeleteFolderNode> Nodes;
+	TMap<FName, int32> NodeIndexMap;
+
+	int32 FirstRootIndex = INDEX_NONE;
+};
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetScanning/AssetContentHashCache.h"
+
+/**
+ * One asset listed in the Advanced Delete tab.
+ * The item index is assigned once when the item is added and never reused, per item state is stored in bit arrays indexed by it.
+ */
+struct FAdvancedDeleteListItem
+{
+	FAdvancedDeleteListItem(FAssetData&& InAssetData, int32 InItemIndex)
+		: AssetData(MoveTemp(InAssetData))
+		, ItemIndex(InItemIndex)
+	{
+	}
+
+	FAssetData AssetData;
+	int32 ItemIndex = INDEX_NONE;
+
+	//Column values captured when the item is added, sorting reads these instead of querying per comparison
+	int32 ReferencerCount = 0;
+	FDateTime LastModified = FDateTime::MinValue();
+
+	//Filled in once the size calculation of the item has finished, -1 when unknown
+	int64 DiskSize = -1;
+	int64 MemorySize = -1;
+	bool bSizesCalculated = false;
+
+	//Only hashed while a filter compares contents, invalid until then
+	FAssetContentHash ContentHash;
+
+	//Only hashed for textures while a filter compares their looks
+	uint64 PerceptualHash = 0;
+	bool bPerceptualHashed = false;
+
+	//Item index of the first texture in its cluster of similar looks, set when the tab clusters the hashed textures
+	int32 SimilarTextureClusterId = INDEX_NONE;
+
+	//Only hashed for static meshes while a filter compares their geometry
+	uint64 GeometryHash = 0;
+	bool bGeometryHashed = false;
+};
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Case insensitive substring index over the asset names and package paths of the Advanced Delete items.
+ * Every lowercase trigram maps to the ascending list of items containing it, so a query only verifies the items
+ * found in all of its trigram lists. Queries shorter than a trigram read the list of their one or two characters,
+ * so every query length matches substrings of names and paths alike.
+ * Items are added in item index order and removed items are only masked out, item indices are never reused.
+ */
+class FAdvancedDeleteSearchIndex
+{
+public:
+	void AddItem(int32 ItemIndex, FName AssetName, FName PackagePath);
+	void RemoveItem(int32 ItemIndex);
+	void Reset();
+
+	//Sets the bit of every live item matching the query, OutMatchingItems is sized to cover every item index
+	void Search(FStringView Query, TBitArray<>& OutMatchingItems) const;
+
+private:
+	typedef uint64 FTrigramKey;
+
+	static FTrigramKey MakeTrigramKey(TCHAR First, TCHAR Second, TCHAR Third);
+
+	void AddGramsOfText(int32 ItemIndex, FStringView Text);
+	void AddToPostingList(TMap<FTrigramKey, TArray<int32>>& PostingLists, FTrigramKey Key, int32 ItemIndex);
+
+	bool DoesItemMatch(int32 ItemIndex, FStringView Query) const;
+
+	TMap<FTrigramKey, TArray<int32>> TrigramPostingLists;
+
+	//One and two character substrings, keyed like trigrams with the missing characters left zero
+	TMap<FTrigramKey, TArray<int32>> ShortGramPostingLists;
+
+	TArray<FName> ItemAssetNames;
+	TArray<FName> ItemPackagePaths;
+	TBitArray<> LiveItems;
+};
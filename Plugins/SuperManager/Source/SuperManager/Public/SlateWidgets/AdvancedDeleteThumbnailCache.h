@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+
+class FAssetThumbnail;
+class FAssetThumbnailPool;
+struct FAdvancedDeleteListItem;
+
+/**
+ * Thumbnails of the Advanced Delete rows, rendered by one thumbnail pool shared by every row of the tab.
+ * The number of thumbnails kept follows from a memory budget, the least recently requested one is dropped when it is full.
+ * Only realized rows request thumbnails, and the pool reads the thumbnail saved in the package for assets that are not loaded,
+ * so scrolling never loads the assets themselves.
+ */
+class FAdvancedDeleteThumbnailCache
+{
+public:
+	FAdvancedDeleteThumbnailCache(int32 InThumbnailResolution, int64 MemoryBudget);
+	~FAdvancedDeleteThumbnailCache();
+
+	int32 GetThumbnailResolution() const { return ThumbnailResolution; }
+
+	//Creates the thumbnail on the first request, every request marks it as the most recently used
+	TSharedRef<FAssetThumbnail> FindOrAddThumbnail(const FAdvancedDeleteListItem& Item);
+
+	//Drops the thumbnail of an item that changed or was deleted, rows still showing it keep their copy until regenerated
+	void RemoveThumbnail(int32 ItemIndex);
+
+private:
+	int32 ThumbnailResolution;
+
+	TSharedPtr<FAssetThumbnailPool> ThumbnailPool;
+
+	TLruCache<int32, TSharedPtr<FAssetThumbnail>> Thumbnails;
+};
@@ -3,41 +3,340 @@
 #pragma once
 
 #include "Widgets/SCompoundWidget.h"
+#include "SlateWidgets/AdvancedDeleteListItem.h"
+#include "SlateWidgets/AdvancedDeleteSearchIndex.h"
+#include "SlateWidgets/AdvancedDeleteFolderTree.h"
+#include "SlateWidgets/AdvancedDeleteFilters.h"
+
+class FAsyncAssetDataGatherer;
+class FAsyncAssetSizeCalculator;
+class FAsyncAssetContentHasher;
+class FAsyncTexturePerceptualHasher;
+class FAsyncAssetSourceLoader;
+struct FLoadedAssetSource;
+class FAsyncStaticMeshGeometryHasher;
+class FAssetReferenceGraph;
+class FAdvancedDeleteThumbnailCache;
+struct FGatheredAssetData;
 
 class SAdvancedDeleteTab : public SCompoundWidget
 {
 	SLATE_BEGIN_ARGS(SAdvancedDeleteTab) {}
 
-	SLATE_ARGUMENT(TArray<TSharedPtr<FAssetData>>, AssetsDataToStore)
+	SLATE_ARGUMENT(TSharedPtr<FAsyncAssetDataGatherer, ESPMode::ThreadSafe>, AssetDataGatherer)
 	
 	SLATE_ARGUMENT(FString, CurrentSelectedFolder)
+
+	SLATE_ARGUMENT(TArray<FString>, ScanFolderPaths)
 	
 	SLATE_END_ARGS()
 
 public:
 	void Construct(const FArguments& InArgs);
 
+	virtual ~SAdvancedDeleteTab() override;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	//Lets the list scrolling test fill the tab without gathering and count the rows it constructs
+	void AddItemsForTesting(TArray<FGatheredAssetData>&& GatheredAssetsData);
+	TSharedPtr<STreeView<TSharedPtr<FAdvancedDeleteListItem>>> GetAssetListViewForTesting() const { return ConstructedAssetListView; }
+	int32 GetNumConstructedRowsForTesting() const { return NumConstructedRows; }
+#endif
+
 private:
-	TArray<TSharedPtr<FAssetData>> StoredAssetsData;
-	TArray<TSharedPtr<FAssetData>> DisplayedAssetsData;;
-	TArray<TSharedRef<SCheckBox>> CheckboxesArray;
-	TArray<TSharedPtr<FAssetData>> AssetsDataToDeleteArray;
+	TArray<TSharedPtr<FAdvancedDeleteListItem>> StoredAssetsData;
+
+	//Stored items passing the listing condition, in sort order
+	TArray<TSharedPtr<FAdvancedDeleteListItem>> ListedAssetsData;
+
+	//Listed items matching the search text, every displayed item whether or not its group is expanded
+	TArray<TSharedPtr<FAdvancedDeleteListItem>> DisplayedAssetsData;
+
+	//Checked state of every item by item index, rows only read and write it so unrealized items are covered too
+	TBitArray<> CheckedItems;
+	int32 NextItemIndex = 0;
+
+	//Every stored item by asset path, so registry changes find their row without a scan
+	TMap<FSoftObjectPath, TSharedPtr<FAdvancedDeleteListItem>> ItemsByAssetPath;
+
+	//Every stored item by package name, so a package whose referencers changed finds its items without a scan
+	TMultiMap<FName, TSharedPtr<FAdvancedDeleteListItem>> StoredItemsByPackageName;
+
+	//Returns null when the asset is already stored, registry events can report an asset before the gatherer does
+	TSharedPtr<FAdvancedDeleteListItem> AddStoredItem(FGatheredAssetData&& GatheredAssetData, const FAssetReferenceGraph& ReferenceGraph);
+
+	bool IsItemChecked(const TSharedPtr<FAdvancedDeleteListItem>& Item) const { return CheckedItems[Item->ItemIndex]; }
+
+	//Every item ever stored by item index, null once the item is removed, so async results find their item with one read
+	TArray<FAdvancedDeleteListItem*> StoredItemsByIndex;
+
+	FAdvancedDeleteListItem* FindStoredItem(int32 ItemIndex) const { return StoredItemsByIndex[ItemIndex]; }
+
+	//Drops the items from the stored, listed and displayed items in one pass each, returns how many were stored
+	int32 RemoveStoredItems(const TSet<FSoftObjectPath>& RemovedAssetPaths);
+
+	//Removes the deleted items and updates the list for them
+	void RemoveDeletedItems(const TSet<FSoftObjectPath>& DeletedAssetPaths);
 	
-	TSharedRef<SListView<TSharedPtr<FAssetData>>> ConstructAssetListView();
-	TSharedPtr<SListView<TSharedPtr<FAssetData>>> ConstructedAssetListView;
+	TSharedRef<STreeView<TSharedPtr<FAdvancedDeleteListItem>>> ConstructAssetListView();
+	TSharedPtr<STreeView<TSharedPtr<FAdvancedDeleteListItem>>> ConstructedAssetListView;
 	void RefreshAssetListView();
 
-#pragma region ComboBoxForListingCondition
+#pragma region DuplicateGroups
+
+	//The asset list's source, the displayed items themselves or one item per duplicate group
+	TArray<TSharedPtr<FAdvancedDeleteListItem>> AssetListRootItems;
+
+	//The other items of every duplicate group, keyed by the item index of the group's root item
+	TMap<int32, TArray<TSharedPtr<FAdvancedDeleteListItem>>> DuplicateGroupMembers;
+
+	//Groups the displayed items while a duplicate filter is active, in their displayed order
+	void RebuildAssetListRootItems();
+
+	void OnGetAssetListChildren(TSharedPtr<FAdvancedDeleteListItem> Item, TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutChildItems);
+
+	//Number of items in the group the item is the root of, zero for items not rooting a group
+	int32 GetDuplicateGroupSize(const TSharedPtr<FAdvancedDeleteListItem>& Item) const;
+
+#pragma endregion
+
+#pragma region AssetListSorting
+
+	TSharedRef<SHeaderRow> ConstructHeaderRow();
+	TSharedPtr<SHeaderRow> ConstructedHeaderRow;
+
+	FName SortColumnId = NAME_None;
+	EColumnSortMode::Type SortMode = EColumnSortMode::None;
+
+	EColumnSortMode::Type GetColumnSortMode(FName ColumnId) const;
+	void OnColumnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type NewSortMode);
+
+	bool IsListSorted() const;
+
+	void SortListedAssetsData();
+	void SortAssetItems(TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items) const;
+
+	//Merges items sorted by the current column into items already sorted by it in one linear pass
+	void MergeIntoSortedItems(TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items, TArray<TSharedPtr<FAdvancedDeleteListItem>>&& SortedNewItems) const;
+
+#pragma endregion
+
+#pragma region StreamingGatheredAssets
+
+	TSharedPtr<FAsyncAssetDataGatherer, ESPMode::ThreadSafe> AssetDataGatherer;
 
-	TSharedRef<SComboBox<TSharedPtr<FString>>> ConstructComboBox();
+	EActiveTimerReturnType OnStreamGatheredAssets(double InCurrentTime, float InDeltaTime);
 
-	TArray<TSharedPtr<FString>> ComboBoxSourceItems;
+	//Lists the new items and keeps the listed items in sort order
+	void AppendToListedAssetsData(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& NewItems);
 
-	TSharedRef<SWidget> OnGenerateComboContent(TSharedPtr<FString> SourceItem);
+	TSharedRef<SWidget> ConstructGatheringProgressWidget();
 
-	void OnComboSelectionChanged(TSharedPtr<FString> SelectedOption, ESelectInfo::Type InSelectInfo);
+	bool IsGatheringAssets() const;
 
-	TSharedPtr<STextBlock> ComboDisplayTextBlock;
+#pragma endregion
+
+#pragma region AssetSizes
+
+	TSharedPtr<FAsyncAssetSizeCalculator, ESPMode::ThreadSafe> SizeCalculator;
+
+	//Totals of every folder holding sized assets, including everything below it
+	FAdvancedDeleteFolderTree FolderSizeTree;
+
+	bool bIsPollingSizeResults = false;
+
+	void StartPollingSizeResults();
+
+	void EnqueueSizeCalculation(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items);
+
+	EActiveTimerReturnType OnPollSizeResults(double InCurrentTime, float InDeltaTime);
+
+	bool AreSizesPending() const { return bIsPollingSizeResults; }
+
+	bool IsSortedBySize() const;
+
+	FText GetFolderSizeTotalsText(FName FolderPath) const;
+
+#pragma endregion
+
+#pragma region ContentHashes
+
+	//Created when a filter first compares contents, so a tab never comparing them never reads a package file
+	TSharedPtr<FAsyncAssetContentHasher, ESPMode::ThreadSafe> ContentHasher;
+
+	bool bIsPollingContentHashResults = false;
+
+	//Starts hashing every stored item the first time an active filter reads content hashes
+	void StartContentHashingIfNeeded();
+
+	//Cached hashes are applied right away, only packages changed since they were hashed are read
+	void EnqueueContentHashing(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items);
+
+	EActiveTimerReturnType OnPollContentHashResults(double InCurrentTime, float InDeltaTime);
+
+	bool AreContentHashesPending() const { return bIsPollingContentHashResults; }
+
+#pragma endregion
+
+#pragma region PerceptualHashes
+
+	//Created when a filter first compares texture looks, so a tab never comparing them never loads a texture
+	TSharedPtr<FAsyncTexturePerceptualHasher, ESPMode::ThreadSafe> TexturePerceptualHasher;
+
+	//Loads the textures whose source is still to be read, and releases the ones it loaded once they are read
+	TSharedPtr<FAsyncAssetSourceLoader> TextureSourceLoader;
+
+	bool bIsHashingTextures = false;
+
+	void StartTextureHashingIfNeeded();
+
+	//Cached hashes are applied right away, only textures resaved since they were hashed are loaded
+	void EnqueueTextureHashing(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items);
+
+	//Textures are clustered once every hash is in, so the pair scan runs once per hashing rather than per result
+	EActiveTimerReturnType OnHashTextures(double InCurrentTime, float InDeltaTime);
+
+	//Reads the source mip closest above the hashed size and hands it to the hasher, false when the texture has no source
+	bool ReadTextureSourceForHashing(const FLoadedAssetSource& LoadedTexture);
+
+	bool AreTextureHashesPending() const { return bIsHashingTextures; }
+
+#pragma endregion
+
+#pragma region GeometryHashes
+
+	//Created when a filter first compares mesh geometry, so a tab never comparing it never loads a mesh
+	TSharedPtr<FAsyncStaticMeshGeometryHasher, ESPMode::ThreadSafe> GeometryHasher;
+
+	//Loads the static meshes whose source model is still to be read, and releases the ones it loaded once they are read
+	TSharedPtr<FAsyncAssetSourceLoader> GeometrySourceLoader;
+
+	bool bIsHashingGeometry = false;
+
+	void StartGeometryHashingIfNeeded();
+
+	//Cached hashes are applied right away, only meshes resaved since they were hashed are loaded
+	void EnqueueGeometryHashing(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& Items);
+
+	EActiveTimerReturnType OnHashGeometry(double InCurrentTime, float InDeltaTime);
+
+	//Copies the source model's corners and hands them to the hasher, false when the mesh has no source geometry
+	bool ReadStaticMeshForHashing(const FLoadedAssetSource& LoadedStaticMesh);
+
+	bool AreGeometryHashesPending() const { return bIsHashingGeometry; }
+
+#pragma endregion
+
+#pragma region Thumbnails
+
+	bool bShowThumbnails = false;
+
+	//Created the first time thumbnails are shown, so a tab never showing them never owns a thumbnail pool
+	TSharedPtr<FAdvancedDeleteThumbnailCache> ThumbnailCache;
+
+	TSharedRef<SCheckBox> ConstructThumbnailToggle();
+	void OnThumbnailsToggled(ECheckBoxState NewState);
+
+	TSharedRef<SWidget> ConstructThumbnailForRowWidget(const TSharedPtr<FAdvancedDeleteListItem>& AssetDataToDisplay);
+
+#pragma endregion
+
+#pragma region LiveRegistryUpdates
+
+	TArray<FString> ScanFolderPaths;
+
+	//Registry changes are collected and applied together, so a bulk delete or import costs one diff
+	TMap<FSoftObjectPath, FAssetData> PendingAddedAssets;
+	TMap<FSoftObjectPath, FAssetData> PendingUpdatedAssets;
+	TSet<FSoftObjectPath> PendingRemovedAssetPaths;
+
+	TSharedPtr<FActiveTimerHandle> RegistryChangesTimerHandle;
+
+	void OnAssetAddedToRegistry(const FAssetData& AddedAssetData);
+	void OnAssetRemovedFromRegistry(const FAssetData& RemovedAssetData);
+	void OnAssetRenamedInRegistry(const FAssetData& RenamedAssetData, const FString& OldObjectPath);
+	void OnAssetUpdatedInRegistry(const FAssetData& UpdatedAssetData);
+
+	void ScheduleRegistryChanges();
+
+	EActiveTimerReturnType OnApplyRegistryChanges(double InCurrentTime, float InDeltaTime);
+
+	//Takes the items out of the listed and displayed items and puts the ones still passing back in sorted position
+	void RelistChangedItems(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ChangedItems);
+
+	bool IsAssetInScanFolders(const FAssetData& AssetData) const;
+
+#pragma endregion
+
+#pragma region SearchBox
+
+	TSharedRef<SWidget> ConstructSearchBox();
+
+	FAdvancedDeleteSearchIndex SearchIndex;
+
+	FString SearchText;
+	FString PendingSearchText;
+
+	TSharedPtr<FActiveTimerHandle> SearchDebounceTimerHandle;
+
+	void OnSearchTextChanged(const FText& InSearchText);
+	void OnSearchTextCommitted(const FText& InSearchText, ETextCommit::Type CommitType);
+
+	EActiveTimerReturnType OnSearchDebounceElapsed(double InCurrentTime, float InDeltaTime);
+
+	//Rebuilds the displayed items from the listed items, keeping their order
+	void ApplySearchFilter();
+
+#pragma endregion
+
+#pragma region FolderTreeView
+
+	bool bShowFolderTree = false;
+
+	//Folders of the displayed items, rebuilt whenever they change while the tree is shown
+	FAdvancedDeleteFolderTree FolderTree;
+
+	TArray<TSharedPtr<FAdvancedDeleteFolderTreeItem>> FolderTreeRootItems;
+
+	//Kept by path, so expansion survives the tree being rebuilt
+	TSet<FName> ExpandedFolderPaths;
+
+	TSharedRef<STreeView<TSharedPtr<FAdvancedDeleteFolderTreeItem>>> ConstructFolderTreeView();
+	TSharedPtr<STreeView<TSharedPtr<FAdvancedDeleteFolderTreeItem>>> ConstructedFolderTreeView;
+
+	TSharedRef<SCheckBox> ConstructFolderTreeToggle();
+	void OnFolderTreeToggled(ECheckBoxState NewState);
+
+	void RebuildFolderTree();
+
+	void CreateChildItems(const TSharedPtr<FAdvancedDeleteFolderTreeItem>& FolderItem);
+	void RestoreFolderExpansion(const TArray<TSharedPtr<FAdvancedDeleteFolderTreeItem>>& FolderItems);
+
+	TSharedRef<ITableRow> OnGenerateRowForFolderTree(TSharedPtr<FAdvancedDeleteFolderTreeItem> FolderItem, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnGetFolderTreeChildren(TSharedPtr<FAdvancedDeleteFolderTreeItem> FolderItem, TArray<TSharedPtr<FAdvancedDeleteFolderTreeItem>>& OutChildItems);
+	void OnFolderTreeExpansionChanged(TSharedPtr<FAdvancedDeleteFolderTreeItem> FolderItem, bool bIsExpanded);
+
+#pragma endregion
+
+#pragma region ListingFilters
+
+	FAdvancedDeleteFilterPipeline FilterPipeline;
+
+	//Label of the filter button, only rebuilt when a filter is toggled
+	FText ActiveFiltersText;
+
+	TSharedRef<SComboButton> ConstructFilterComboButton();
+
+	TSharedRef<SWidget> OnGetFilterMenuContent();
+
+	void OnFilterToggled(int32 FilterIndex);
+
+	//Replaces the output with the items passing every active filter, in input order
+	void ListAssetsForFilters(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& AssetDataToFilter,
+		TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutAssetsData);
+
+	//Drops the memoized results reading the inputs, and lists every item again when an active filter reads them
+	void RelistForChangedInputs(EAdvancedDeleteFilterInputs ChangedInputs);
 
 	TSharedRef<STextBlock> ConstructComboHelpTexts(const FString& TextContent, ETextJustify::Type TextJustify);
 	
@@ -45,18 +344,26 @@ private:
 		
 #pragma region RowWidgetForAssetListView
 	
-	TSharedRef<ITableRow> OnGenerateRowForList(TSharedPtr<FAssetData> AssetDataToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
+	//Built once, every row reads its fonts, styles and fixed texts from here
+	TSharedPtr<const struct FAssetDeleteRowStyle> RowStyle;
 
-	void OnRowWidgetMouseButtonClicked(TSharedPtr<FAssetData> ClickedData);
+	//Rows the list released, reused before a new row is constructed
+	TArray<TSharedRef<class SAssetDeleteRow>> RecycledRows;
 
-	TSharedRef<SCheckBox> ConstructCheckBox(const TSharedPtr<FAssetData> AssetDataToDisplay);
-	void OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData);
+	//Rows constructed rather than recycled, about one screen of them however far the list is scrolled
+	int32 NumConstructedRows = 0;
 
-	TSharedRef<STextBlock> ConstructTextForRowWidget(const FString& TextContent, const FSlateFontInfo& FontToUse);
+	TSharedRef<ITableRow> OnGenerateRowForList(TSharedPtr<FAdvancedDeleteListItem> AssetDataToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
+
+	void OnAssetRowReleased(const TSharedRef<ITableRow>& ReleasedRow);
 
-	TSharedRef<SButton> ConstructButtonForRowWidget(const TSharedPtr<FAssetData> AssetDataToDisplay);
+	void OnRowWidgetMouseButtonClicked(TSharedPtr<FAdvancedDeleteListItem> ClickedData);
 
-	FReply OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAssetData);
+	void SetItemChecked(const TSharedPtr<FAdvancedDeleteListItem>& Item, bool bIsChecked);
+
+	TSharedRef<STextBlock> ConstructTextForRowWidget(const FString& TextContent, const FSlateFontInfo& FontToUse);
+
+	FReply OnDeleteButtonClicked(TSharedPtr<FAdvancedDeleteListItem> ClickedAssetData);
 
 #pragma endregion
 
@@ -71,6 +378,11 @@ private:
 	TSharedRef<SButton> ConstructDeselectAllButton();
 	FReply OnDeselectAllButtonClicked();
 
+	//Consolidates the displayed duplicate groups confirmed one by one, one fixup and save pass covers all of them
+	TSharedRef<SButton> ConstructConsolidateButton();
+	bool CanConsolidateDuplicateGroups() const;
+	FReply OnConsolidateButtonClicked();
+
 	TSharedRef<STextBlock> ConstructTextForTabButtons(const FString& TextContent);
 
 #pragma endregion 
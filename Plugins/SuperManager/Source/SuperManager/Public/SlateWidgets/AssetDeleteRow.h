@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Widgets/Views/STableRow.h"
+#include "SlateWidgets/AdvancedDeleteListItem.h"
+
+namespace AdvancedDeleteColumns
+{
+	static const FName CheckBox(TEXT("CheckBox"));
+	static const FName Thumbnail(TEXT("Thumbnail"));
+	static const FName Name(TEXT("Name"));
+	static const FName Class(TEXT("Class"));
+	static const FName Path(TEXT("Path"));
+	static const FName DiskSize(TEXT("DiskSize"));
+	static const FName MemorySize(TEXT("MemorySize"));
+	static const FName Referencers(TEXT("Referencers"));
+	static const FName LastModified(TEXT("LastModified"));
+	static const FName Delete(TEXT("Delete"));
+}
+
+//Fonts, styles and fixed texts of the asset rows, built once per tab and shared by every row
+struct FAssetDeleteRowStyle
+{
+	FAssetDeleteRowStyle();
+
+	FSlateFontInfo NameFont;
+	FSlateFontInfo ColumnFont;
+
+	const FCheckBoxStyle* CheckBoxStyle = nullptr;
+	const FButtonStyle* DeleteButtonStyle = nullptr;
+
+	FText DeleteText;
+	FText PendingText;
+	FText UnknownText;
+
+	//Name of an item rooting a duplicate group, followed by the number of items in the group
+	FTextFormat GroupNameFormat;
+};
+
+/**
+ * Row of one asset in the Advanced Delete list.
+ * Cells are bound to texts cached on the row, which are only rebuilt when the value behind them changes, so painting allocates nothing.
+ * A released row can be handed another item with SetItem, which keeps every cell widget and only replaces the cached texts.
+ */
+class SAssetDeleteRow : public SMultiColumnTableRow<TSharedPtr<FAdvancedDeleteListItem>>
+{
+public:
+	DECLARE_DELEGATE_RetVal_OneParam(bool, FIsItemChecked, const TSharedPtr<FAdvancedDeleteListItem>&);
+	DECLARE_DELEGATE_TwoParams(FOnItemCheckChanged, const TSharedPtr<FAdvancedDeleteListItem>&, bool);
+	DECLARE_DELEGATE_RetVal_OneParam(FReply, FOnItemDeleteClicked, TSharedPtr<FAdvancedDeleteListItem>);
+	DECLARE_DELEGATE_RetVal_OneParam(FText, FOnGetFolderToolTip, FName);
+	DECLARE_DELEGATE_RetVal_OneParam(TSharedRef<SWidget>, FOnGenerateThumbnail, const TSharedPtr<FAdvancedDeleteListItem>&);
+	DECLARE_DELEGATE_RetVal_OneParam(int32, FOnGetGroupSize, const TSharedPtr<FAdvancedDeleteListItem>&);
+
+	SLATE_BEGIN_ARGS(SAssetDeleteRow) {}
+
+	SLATE_ARGUMENT(TSharedPtr<FAdvancedDeleteListItem>, Item)
+
+	SLATE_ARGUMENT(TSharedPtr<const FAssetDeleteRowStyle>, RowStyle)
+
+	SLATE_EVENT(FIsItemChecked, IsItemChecked)
+
+	SLATE_EVENT(FOnItemCheckChanged, OnItemCheckChanged)
+
+	SLATE_EVENT(FOnItemDeleteClicked, OnItemDeleteClicked)
+
+	SLATE_EVENT(FOnGetFolderToolTip, OnGetFolderToolTip)
+
+	SLATE_EVENT(FOnGenerateThumbnail, OnGenerateThumbnail)
+
+	SLATE_EVENT(FOnGetGroupSize, OnGetGroupSize)
+
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable);
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override;
+
+	void SetItem(const TSharedPtr<FAdvancedDeleteListItem>& InItem);
+
+	//Drops the thumbnail widget while the row waits to be reused, the item is kept so late attribute reads stay valid
+	void ReleaseItem();
+
+private:
+	void RefreshThumbnail();
+
+	ECheckBoxState GetCheckBoxState() const;
+	void OnCheckBoxStateChanged(ECheckBoxState NewState);
+
+	FReply OnDeleteButtonClicked();
+
+	FText GetPathToolTipText() const;
+
+	struct FCachedSizeText
+	{
+		bool bSizeCalculated = false;
+		int64 Size = -1;
+		FText Text;
+	};
+
+	FText GetNameText();
+	FText GetDiskSizeText();
+	FText GetMemorySizeText();
+	FText GetReferencersText();
+	FText GetLastModifiedText();
+
+	const FText& RefreshSizeText(FCachedSizeText& SizeText, int64 Size);
+
+	TSharedPtr<FAdvancedDeleteListItem> Item;
+	TSharedPtr<const FAssetDeleteRowStyle> RowStyle;
+
+	FIsItemChecked IsItemChecked;
+	FOnItemCheckChanged OnItemCheckChanged;
+	FOnItemDeleteClicked OnItemDeleteClicked;
+	FOnGetFolderToolTip OnGetFolderToolTip;
+	FOnGenerateThumbnail OnGenerateThumbnail;
+	FOnGetGroupSize OnGetGroupSize;
+
+	//Texts fixed for the item, set when the item is assigned
+	FText AssetNameText;
+	FText ClassText;
+	FText PathText;
+
+	//Texts of values the tab updates while the item is shown, each with the value it was built from
+	FCachedSizeText DiskSizeText;
+	FCachedSizeText MemorySizeText;
+
+	//Grouping changes with the other displayed items, so the name is cached against the group size
+	FText NameText;
+	int32 CachedGroupSize = INDEX_NONE;
+
+	FText ReferencersText;
+	int32 CachedReferencerCount = INDEX_NONE;
+
+	FText LastModifiedText;
+	FDateTime CachedLastModified;
+
+	TSharedPtr<SBox> ThumbnailBox;
+};
@@ -4,6 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "AssetScanning/AssetReferenceGraph.h"
+#include "AssetScanning/AssetScanCache.h"
+#include "AssetScanning/AssetContentHashCache.h"
+#include "AssetScanning/AssetSourceHashCache.h"
+#include "AssetScanning/AssetPathFilter.h"
+#include "SlateWidgets/AdvancedDeleteListItem.h"
 
 class FSuperManagerModule : public IModuleInterface
 {
@@ -42,7 +48,11 @@ private:
 	TSharedRef<SDockTab> OnSpawnAdvancedDeleteTab(const FSpawnTabArgs& SpawnTabArgs);
 	TSharedPtr<SDockTab> ConstructedDockTab;
 
-	TArray<TSharedPtr<FAssetData>> GetAllAssetDataUnderSelectedFolder();
+	TSharedRef<class FAsyncAssetDataGatherer, ESPMode::ThreadSafe> StartGatheringAssetDataUnderFolders(const TArray<FString>& FolderPaths);
+
+	void QueryAssetDataUnderFolders(const TArray<FString>& RootFolderPaths, TArray<FAssetData>& OutAssetsData);
+
+	static void CollapseNestedFolderPaths(const TArray<FString>& FolderPaths, TArray<FString>& OutRootFolderPaths);
 
 	void OnAdvancedDeleteTabClosed(TSharedRef<SDockTab> TabToClose);
 	
@@ -97,15 +107,120 @@ private:
 	TWeakObjectPtr<class UEditorActorSubsystem> WeakEditorActorSubsystem;
 
 	bool GetEditorActorSubsystem();
+
+#pragma region AssetPathFilter
+
+	void InitAssetPathFilter();
+	void ShutdownAssetPathFilter();
+
+	void OnSuperManagerSettingsChanged(UObject* ChangedSettings, FPropertyChangedEvent& PropertyChangedEvent);
+
+	FAssetPathFilter AssetPathFilter;
+
+#pragma endregion
+
+#pragma region AssetReferenceTracking
+
+	void InitAssetReferenceTracking();
+	void ShutdownAssetReferenceTracking();
+
+	void OnAssetRegistryFilesLoaded();
+	void OnAssetAddedToRegistry(const FAssetData& AddedAssetData);
+	void OnAssetRemovedFromRegistry(const FAssetData& RemovedAssetData);
+	void OnAssetRenamedInRegistry(const FAssetData& RenamedAssetData, const FString& OldObjectPath);
+	void OnAssetUpdatedInRegistry(const FAssetData& UpdatedAssetData);
+
+	//Drops what the caches hold for a package once no asset lives in it anymore
+	void RemoveMissingPackageFromCaches(FName PackageName);
+
+	void BuildAssetReferenceGraph(IAssetRegistry& AssetRegistry);
+
+	FAssetReferenceGraph AssetReferenceGraph;
+
+	FAssetScanCache AssetScanCache;
+	bool bAssetScanCacheLoaded = false;
+
+	void GatherReachabilityRootPackages(const FAssetReferenceGraph& ReferenceGraph, TArray<int32>& OutRootPackageIndices);
+
+#pragma endregion
+
+#pragma region ContentHashing
+
+	//Loaded the first time a tab compares contents
+	FAssetContentHashCache AssetContentHashCache;
+	bool bAssetContentHashCacheLoaded = false;
+
+	void PruneAssetContentHashCache();
+
+	//Loaded the first time a tab compares texture looks
+	FAssetSourceHashCache PerceptualHashCache;
+	bool bPerceptualHashCacheLoaded = false;
+
+	//Loaded the first time a tab compares mesh geometry
+	FAssetSourceHashCache GeometryHashCache;
+	bool bGeometryHashCacheLoaded = false;
+
+	void PruneSourceHashCache(FAssetSourceHashCache& SourceHashCache);
+
+	//False for packages deleted or renamed, only meaningful once the graph is built
+	bool DoesPackageExist(FName PackageName) const;
+
+#pragma endregion
+
+#pragma region ChunkedDeletion
+
+	bool DeleteAssetsInChunks(const TArray<FAssetData>& AssetsToDelete, TSet<FSoftObjectPath>& OutDeletedAssetPaths);
+
+	void GatherDeletedAssetPaths(const TArray<FAssetData>& AssetsToDelete, TSet<FSoftObjectPath>& OutDeletedAssetPaths);
+
+#pragma endregion
 	
 public:
 
+	const FAssetPathFilter& GetAssetPathFilter() const { return AssetPathFilter; }
+
+	const FAssetReferenceGraph& GetAssetReferenceGraph();
+
+	//Packages the registry events added or dropped hard or soft referencers of since the last call
+	void ConsumeReferencerCountChanges(TArray<FName>& OutPackageNames) { AssetReferenceGraph.ConsumeReferencerCountChanges(OutPackageNames); }
+
+#pragma region ProcessDataForAuditing
+
+	void GatherAssetDataUnderFolders(const TArray<FString>& FolderPaths, TArray<FAssetData>& OutAssetsData);
+	bool ScanForUnusedAssets(const TArray<FAssetData>& AssetsData, TArray<FAssetData>& OutUnusedAssetsData);
+	void ListEmptyFoldersUnderFolders(const TArray<FString>& FolderPaths, TArray<FString>& OutEmptyFolderPaths);
+
+#pragma endregion
+
 #pragma region ProccessDataForAdvancedDeleteTab
 
 	bool DeleteSingleAssetForAssetList(const FAssetData& AssetDataToDelete);
-	bool DeleteMultipleAssetsForAssetsList(const TArray<FAssetData>& AssetsToDelete);
-	void ListUnusedAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TArray<TSharedPtr<FAssetData>>& OutUnusedAssetsData);
-	void ListSameNameAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TArray<TSharedPtr<FAssetData>>& OutSameNameAssetsData);
+	bool DeleteMultipleAssetsForAssetsList(const TArray<FAssetData>& AssetsToDelete, TSet<FSoftObjectPath>& OutDeletedAssetPaths);
+	//The first asset of each group is kept, references to the others are retargeted to it before they are removed.
+	//Hashes can collide, so only members serializing exactly like the kept asset are consolidated.
+	//Retargeted referencers are saved, the ones holding unsaved edits from before only where the user confirms it
+	bool ConsolidateDuplicatesForAssetList(const TArray<TArray<FAssetData>>& DuplicateGroups, TSet<FSoftObjectPath>& OutConsolidatedAssetPaths);
+	void MarkReachablePackages(TBitArray<>& OutReachablePackages);
+	void ListSameNameAssetsForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToFilter, TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutSameNameItems);
+	//Groups in order of their first item, items keep their order within a group
+	void GroupSameNameAssetsForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToGroup, TArray<TArray<TSharedPtr<FAdvancedDeleteListItem>>>& OutSameNameGroups);
+	//Only items with a content hash are compared, see FAdvancedDeleteListItem::ContentHash
+	void ListSameContentAssetsForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToFilter, TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutSameContentItems);
+	void GroupSameContentAssetsForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToGroup, TArray<TArray<TSharedPtr<FAdvancedDeleteListItem>>>& OutSameContentGroups);
+	//Only static meshes with a geometry hash are compared
+	void ListSameGeometryAssetsForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToFilter, TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutSameGeometryItems);
+	void GroupSameGeometryAssetsForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToGroup, TArray<TArray<TSharedPtr<FAdvancedDeleteListItem>>>& OutSameGeometryGroups);
+	//Only textures with a perceptual hash are clustered, within the distance set in the settings. Listing and grouping
+	//similar textures only read the clusters, so they stay as they are until the items are clustered again
+	void ClusterSimilarTexturesForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToCluster);
+	void ListSimilarTexturesForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToFilter, TArray<TSharedPtr<FAdvancedDeleteListItem>>& OutSimilarItems);
+	void GroupSimilarTexturesForAssetList(const TArray<TSharedPtr<FAdvancedDeleteListItem>>& ItemsToGroup, TArray<TArray<TSharedPtr<FAdvancedDeleteListItem>>>& OutSimilarGroups);
+	FAssetContentHashCache& GetAssetContentHashCache();
+	void SaveAssetContentHashCache();
+	FAssetSourceHashCache& GetPerceptualHashCache();
+	void SavePerceptualHashCache();
+	FAssetSourceHashCache& GetGeometryHashCache();
+	void SaveGeometryHashCache();
 	void SyncSBToClickedAssetForAssetList(const FString& AssetPathToSync);
 	
 #pragma endregion
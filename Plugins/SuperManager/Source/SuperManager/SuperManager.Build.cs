@@ -33,7 +33,8 @@ public class SuperManager : ModuleRules
 				"UnrealEd",
 				"InputCore",
 				"Projects",
-				"SceneOutliner"
+				"SceneOutliner",
+				"DeveloperSettings"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -46,6 +47,10 @@ public class SuperManager : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"DeveloperToolSettings",
+				"ImageCore",
+				"MeshDescription",
+				"StaticMeshDescription",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);